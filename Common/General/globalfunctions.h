@@ -110,6 +110,12 @@ enum UpdateIndex {
     UpdateDiff = 1,
 };
 
+enum PushNotifyType {
+    PUSH_GAME_CHANGED    = 1,
+    PUSH_TICKET_CHANGED  = 2,
+    PUSH_MEETING_CHANGED = 3,
+};
+
 extern CompetitionIndex getCompetitionIndex(QString comp);
 extern QString getCompetitionString(CompetitionIndex index);
 extern QString createRandomString(qint32 size);
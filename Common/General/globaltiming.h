@@ -35,12 +35,25 @@
 #define CON_LOGIN_TIMEOUT_MSEC (2 * 60 * 1000)
 #endif
 
+// clang-format off
+#define PUSH_RETRY_TIMEOUT_MSEC     (3 * 1000)
+#define PUSH_MAX_RETRIES            3
+// clang-format on
+
 #ifdef QT_DEBUG
 #define SOCKET_TIMEOUT_MS 5000
 #else
 #define SOCKET_TIMEOUT_MS 30000
 #endif
 
+/* Retransmission of requests before SOCKET_TIMEOUT_MS, the timeout follows the measured round trip time */
+// clang-format off
+#define RETRANSMIT_INITIAL_RTO_MS   qint64(1000)
+#define RETRANSMIT_MIN_RTO_MS       qint64(200)
+#define RETRANSMIT_MAX_RTO_MS       qint64(8000)
+#define RETRANSMIT_MAX_RETRIES      6
+// clang-format on
+
 // clang-format off
 #ifdef QT_DEBUG
 #define TIMEOUT_LOAD_GAMEINFO   qint64(10 * 60 * 1000) // 10min
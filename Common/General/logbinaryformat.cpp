@@ -0,0 +1,212 @@
+/*
+*	This file is part of StamOrga
+*   Copyright (C) 2017 Markus Schneider
+*
+*	This program is free software; you can redistribute it and/or modify
+*   it under the terms of the GNU General Public License as published by
+*   the Free Software Foundation; either version 3 of the License, or
+*   (at your option) any later version.
+*
+*	StamOrga is distributed in the hope that it will be useful,
+*    but WITHOUT ANY WARRANTY; without even the implied warranty of
+*    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+*    GNU General Public License for more details.
+
+*    You should have received a copy of the GNU General Public License
+*    along with StamOrga.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include <QtCore/QDateTime>
+#include <QtCore/QStringList>
+
+#include "logbinaryformat.h"
+
+static void appendVarUInt(QByteArray& data, quint64 value)
+{
+    while (value >= 0x80) {
+        data.append(char((value & 0x7F) | 0x80));
+        value >>= 7;
+    }
+    data.append(char(value));
+}
+
+static bool readVarUInt(const QByteArray& data, int& pos, quint64& value)
+{
+    value = 0;
+    for (int shift = 0; pos < data.size() && shift < 64; shift += 7) {
+        quint8 byte = quint8(data[pos++]);
+        value |= quint64(byte & 0x7F) << shift;
+        if ((byte & 0x80) == 0)
+            return true;
+    }
+    return false;
+}
+
+static bool readString(const QByteArray& data, int& pos, QString& value)
+{
+    quint64 length;
+    if (!readVarUInt(data, pos, length) || length > quint64(data.size() - pos))
+        return false;
+    value = QString::fromUtf8(data.constData() + pos, int(length));
+    pos += int(length);
+    return true;
+}
+
+static void appendString(QByteArray& data, const QString& value)
+{
+    QByteArray utf8 = value.toUtf8();
+    appendVarUInt(data, utf8.size());
+    data.append(utf8);
+}
+
+static QString getTypeName(quint8 type)
+{
+    switch (type) {
+    case QtDebugMsg:
+        return "debug";
+    case QtInfoMsg:
+        return "info";
+    case QtWarningMsg:
+        return "warning";
+    case QtCriticalMsg:
+        return "critical";
+    case QtFatalMsg:
+        return "fatal";
+    default:
+        return "unknown";
+    }
+}
+
+LogBinaryWriter::LogBinaryWriter()
+{
+    this->reset();
+}
+
+/* Has to be called when a new file is started, templates and time are written again */
+void LogBinaryWriter::reset()
+{
+    this->m_templates.clear();
+    this->m_lastTimeStamp = 0;
+    this->m_bTimeWritten  = false;
+}
+
+void LogBinaryWriter::appendEntry(QByteArray& data, qint64 timeStamp, QtMsgType type, const QString& msg)
+{
+    QString     tmpl;
+    QStringList args;
+    int         argStart = -1;
+    for (int i = 0; i <= msg.size(); i++) {
+        bool bDigit = i < msg.size() && msg[i] >= QChar('0') && msg[i] <= QChar('9');
+        if (bDigit) {
+            if (argStart < 0)
+                argStart = i;
+            continue;
+        }
+        if (argStart >= 0) {
+            args.append(msg.mid(argStart, i - argStart));
+            tmpl.append(LOG_BINARY_ARG_MARK);
+            argStart = -1;
+        }
+        if (i < msg.size())
+            tmpl.append(msg[i] == LOG_BINARY_ARG_MARK ? QChar('?') : msg[i]);
+    }
+
+    quint32 templateID;
+    QHash<QString, quint32>::const_iterator it = this->m_templates.constFind(tmpl);
+    if (it == this->m_templates.constEnd()) {
+        templateID = this->m_templates.size();
+        this->m_templates.insert(tmpl, templateID);
+        data.append(char(LOG_RECORD_TEMPLATE));
+        appendVarUInt(data, templateID);
+        appendString(data, tmpl);
+    } else
+        templateID = it.value();
+
+    if (!this->m_bTimeWritten) {
+        data.append(char(LOG_RECORD_TIME));
+        appendVarUInt(data, quint64(timeStamp));
+        this->m_lastTimeStamp = timeStamp;
+        this->m_bTimeWritten  = true;
+    }
+
+    qint64 diff = timeStamp - this->m_lastTimeStamp;
+    this->m_lastTimeStamp = timeStamp;
+
+    data.append(char(LOG_RECORD_MESSAGE));
+    appendVarUInt(data, (quint64(diff) << 1) ^ quint64(diff >> 63));
+    data.append(char(type));
+    appendVarUInt(data, templateID);
+    appendVarUInt(data, args.size());
+    foreach (const QString& arg, args)
+        appendString(data, arg);
+}
+
+bool LogBinaryWriter::isBinaryLog(const QByteArray& data)
+{
+    return data.startsWith(LOG_BINARY_HEADER);
+}
+
+/* Converts a binary log to the text format of the normal log file, false when it is broken */
+bool LogBinaryWriter::decode(const QByteArray& data, QString& text)
+{
+    if (!isBinaryLog(data))
+        return false;
+
+    QHash<quint32, QString> templates;
+    qint64                  timeStamp = 0;
+    int                     pos       = int(qstrlen(LOG_BINARY_HEADER));
+
+    while (pos < data.size()) {
+        quint8  record = quint8(data[pos++]);
+        quint64 value;
+        switch (record) {
+        case LOG_RECORD_TEMPLATE: {
+            QString tmpl;
+            if (!readVarUInt(data, pos, value) || !readString(data, pos, tmpl))
+                return false;
+            /* after a restart the same id can be defined again, the latest one is valid */
+            templates.insert(quint32(value), tmpl);
+            break;
+        }
+
+        case LOG_RECORD_TIME:
+            if (!readVarUInt(data, pos, value))
+                return false;
+            timeStamp = qint64(value);
+            break;
+
+        case LOG_RECORD_MESSAGE: {
+            if (!readVarUInt(data, pos, value) || pos >= data.size())
+                return false;
+            timeStamp += qint64(value >> 1) ^ -qint64(value & 1);
+            quint8 type = quint8(data[pos++]);
+
+            quint64 templateID, count;
+            if (!readVarUInt(data, pos, templateID) || !readVarUInt(data, pos, count))
+                return false;
+
+            QString tmpl = templates.value(quint32(templateID));
+            QString msg;
+            for (int i = 0; i < tmpl.size(); i++) {
+                if (tmpl[i] != LOG_BINARY_ARG_MARK) {
+                    msg.append(tmpl[i]);
+                    continue;
+                }
+                QString arg;
+                if (count == 0 || !readString(data, pos, arg))
+                    return false;
+                msg.append(arg);
+                count--;
+            }
+
+            text.append(QDateTime::fromMSecsSinceEpoch(timeStamp).toString("dd.MM hh:mm:ss.zzz"));
+            text.append(" " + getTypeName(type) + " - " + msg + "\n");
+            break;
+        }
+
+        default:
+            return false;
+        }
+    }
+    return true;
+}
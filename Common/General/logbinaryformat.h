@@ -0,0 +1,63 @@
+/*
+*	This file is part of StamOrga
+*   Copyright (C) 2017 Markus Schneider
+*
+*	This program is free software; you can redistribute it and/or modify
+*   it under the terms of the GNU General Public License as published by
+*   the Free Software Foundation; either version 3 of the License, or
+*   (at your option) any later version.
+*
+*	StamOrga is distributed in the hope that it will be useful,
+*    but WITHOUT ANY WARRANTY; without even the implied warranty of
+*    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+*    GNU General Public License for more details.
+
+*    You should have received a copy of the GNU General Public License
+*    along with StamOrga.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#ifndef LOGBINARYFORMAT_H
+#define LOGBINARYFORMAT_H
+
+#include <QtCore/QByteArray>
+#include <QtCore/QHash>
+#include <QtCore/QString>
+
+// clang-format off
+#define LOG_BINARY_HEADER       "STLOG1\n"
+#define LOG_BINARY_ARG_MARK     QChar(0x1A)     /* position of an argument in a template */
+
+#define LOG_RECORD_TEMPLATE     1
+#define LOG_RECORD_MESSAGE      2
+#define LOG_RECORD_TIME         3
+// clang-format on
+
+/*
+ * Writes log messages in a compact binary format. Every number in a message is taken out as
+ * argument, the remaining template is only written once per file and afterwards referenced by
+ * its id. Times are stored as difference to the previous message.
+ *
+ * File:     header, records
+ * Template: [1][id][length][utf8]
+ * Message:  [2][zigzag time difference][type][template id][count]{[length][utf8]}
+ * Time:     [3][msecs since epoch], base for the following differences
+ * Numbers are written as variable length integer with 7 bits per byte.
+ */
+class LogBinaryWriter
+{
+public:
+    LogBinaryWriter();
+
+    void reset();
+    void appendEntry(QByteArray& data, qint64 timeStamp, QtMsgType type, const QString& msg);
+
+    static bool isBinaryLog(const QByteArray& data);
+    static bool decode(const QByteArray& data, QString& text);
+
+private:
+    QHash<QString, quint32> m_templates;
+    qint64                  m_lastTimeStamp;
+    bool                    m_bTimeWritten;
+};
+
+#endif // LOGBINARYFORMAT_H
@@ -17,7 +17,9 @@
 */
 
 #include <QtCore/QDateTime>
-#include <QtCore/QTextStream>
+#include <QtCore/QRegularExpression>
+
+#include <algorithm>
 
 #include <iostream>
 
@@ -25,15 +27,24 @@
 #include "logging.h"
 
 #define LOG_FILE_DATE_FORMAT "yyyy_MM_dd"
+#define LOG_FILE_TEXT_SUFFIX ".log"
+#define LOG_FILE_BINARY_SUFFIX ".blog"
+#define LOG_FILE_PACKED_SUFFIX ".z"
 
 #define TEST
 
 #if defined(Q_OS_ANDROID) || defined(Q_OS_IOS)
 #define MAX_DAYS_LOG_FILES 5
 #else
-#define MAX_DAYS_LOG_FILES 30
+#define MAX_DAYS_LOG_FILES 90
 #endif
 
+/* The name of a log file starts with its date, e.g. 2017_08_01.log or 2017_08_01.blog.z */
+static QDate getLogFileDate(const QString& fileName)
+{
+    return QDate::fromString(fileName.section('.', 0, 0), LOG_FILE_DATE_FORMAT);
+}
+
 Logging* g_Logging = NULL;
 
 void logMyMessageLogginOutPut(QtMsgType type, const QMessageLogContext& context, const QString& msg)
@@ -45,11 +56,65 @@ void logMyMessageLogginOutPut(QtMsgType type, const QMessageLogContext& context,
 }
 
 
+LogRingBuffer::LogRingBuffer()
+{
+    for (quint32 i = 0; i < LOG_RING_SIZE; i++)
+        this->m_entries[i].m_sequence.store(i);
+}
+
+bool LogRingBuffer::push(QtMsgType type, const QString& msg)
+{
+    quint32 pos = this->m_writePos.loadAcquire();
+    while (true) {
+        LogEntry* entry = &this->m_entries[pos & (LOG_RING_SIZE - 1)];
+        qint32    diff  = qint32(entry->m_sequence.loadAcquire() - pos);
+        if (diff == 0) {
+            if (type == QtDebugMsg && qint32(pos - this->m_readPos.loadAcquire()) >= LOG_RING_DEBUG_LIMIT)
+                break;
+            /* reserve the entry, on failure pos contains the current write position */
+            if (this->m_writePos.testAndSetOrdered(pos, pos + 1, pos)) {
+                entry->m_type    = type;
+                entry->m_message = msg;
+                entry->m_sequence.storeRelease(pos + 1);
+                return true;
+            }
+        } else if (diff < 0)
+            break; /* full */
+        else
+            pos = this->m_writePos.loadAcquire();
+    }
+
+    this->m_dropped.fetchAndAddRelaxed(1);
+    return false;
+}
+
+bool LogRingBuffer::pop(QtMsgType& type, QString& msg)
+{
+    quint32   pos   = this->m_readPos.load();
+    LogEntry* entry = &this->m_entries[pos & (LOG_RING_SIZE - 1)];
+    if (qint32(entry->m_sequence.loadAcquire() - (pos + 1)) < 0)
+        return false;
+
+    type = entry->m_type;
+    msg  = entry->m_message;
+    entry->m_message.clear();
+    entry->m_sequence.storeRelease(pos + LOG_RING_SIZE);
+    this->m_readPos.storeRelease(pos + 1);
+    return true;
+}
+
 Logging::Logging(QObject* parent)
     : BackgroundWorker(parent)
 {
-    this->m_logFile   = NULL;
-    this->m_hourTimer = NULL;
+    this->m_logFile       = NULL;
+    this->m_hourTimer     = NULL;
+    this->m_bBinaryFormat = false;
+
+    this->m_historyLines.resize(LOG_HISTORY_LINES);
+    this->m_historyTimes.resize(LOG_HISTORY_LINES);
+    this->m_historyStart = 0;
+    this->m_historyCount = 0;
+    this->m_historyTotal = 0;
 }
 
 void Logging::initialize()
@@ -65,65 +130,286 @@ void Logging::initialize()
 int Logging::DoBackgroundWork()
 {
 
-    this->m_hourTimer = new QTimer();
-    this->m_hourTimer->setSingleShot(true);
-    connect(this->m_hourTimer, &QTimer::timeout, this, &Logging::slotEveryHourTimeout);
-
-    this->slotEveryHourTimeout();
-
     QString loggingPath = this->createLoggingFilePath();
 
     if (loggingPath.size() > 0) {
 
-        /* Read all old log files */
+        /* Read all old log files, the ones of past days which were not packed yet are packed now */
         QStringList nameFilter;
-        nameFilter << "*.log";
+        nameFilter << "*" LOG_FILE_TEXT_SUFFIX << "*" LOG_FILE_BINARY_SUFFIX << "*" LOG_FILE_PACKED_SUFFIX;
         QFileInfo   fileInfo(loggingPath);
         QDir        configDir(fileInfo.absoluteDir());
-        QStringList infoConfigList = configDir.entryList(nameFilter, QDir::Files | QDir::Readable);
+        QStringList infoConfigList = configDir.entryList(nameFilter, QDir::Files | QDir::Readable, QDir::Name);
         foreach (QString file, infoConfigList) {
-            QDate fileDate = QDate::fromString(file.replace(".log", ""), LOG_FILE_DATE_FORMAT);
-            if (fileDate.isValid())
-                this->m_lastLogFiles.append(configDir.path() + "/" + file + ".log");
+            QDate fileDate = getLogFileDate(file);
+            if (!fileDate.isValid())
+                continue;
+            QString filePath = configDir.path() + "/" + file;
+            if (fileDate != QDate::currentDate() && !file.endsWith(LOG_FILE_PACKED_SUFFIX))
+                filePath = this->compressLogFile(filePath);
+            if (!this->m_lastLogFiles.contains(filePath))
+                this->m_lastLogFiles.append(filePath);
         }
     }
 
+    this->m_hourTimer = new QTimer();
+    this->m_hourTimer->setSingleShot(true);
+    connect(this->m_hourTimer, &QTimer::timeout, this, &Logging::slotEveryHourTimeout);
+
+    this->slotEveryHourTimeout();
+
     connect(this, &Logging::signalNewLogEntries, this, &Logging::slotNewLogEntries);
+    /* messages from before the connect did not get a signal */
+    this->slotNewLogEntries();
 
     return 0;
 }
 
 void Logging::addNewEntry(QtMsgType type, /*const QMessageLogContext context, */ const QString& msg)
 {
-    LogEntry* entry = new LogEntry();
-    entry->m_type   = type;
-    //    entry->m_context = context;
-    entry->m_message = msg;
-    {
-        QMutexLocker lock(&this->m_entryListMutex);
-        this->m_logEntries.append(entry);
-    }
+    if (!this->m_logRing.push(type, msg))
+        return;
 
-    emit this->signalNewLogEntries();
+    /* only one signal is pending at a time, the slot takes everything which is in the ring */
+    if (this->m_wakeupPending.testAndSetOrdered(0, 1))
+        emit this->signalNewLogEntries();
 }
 
 int Logging::showLoggingInfo(quint16 numbOfLines)
 {
+    QStringList lines = this->getLastHistoryLines(numbOfLines);
+    foreach (const QString& line, lines)
+        std::cout << line.toStdString() << std::endl;
+
+    return numbOfLines;
+}
+
+/*
+ * Returns one page of LOG_PAGE_LINES lines of a log file or of the current log when there is
+ * no file for index. Page 0 are the newest lines, higher pages go back in time.
+ */
+QString Logging::getCurrentLoggingList(int index, int page)
+{
+    if (page < 0)
+        page = 0;
+
+    QString path;
+    this->m_internalMutex.lock();
+    if (index >= 0 && index < this->m_lastLogFiles.size())
+        path = this->m_lastLogFiles[index];
+    this->m_internalMutex.unlock();
+
+    if (path.isEmpty())
+        return this->getLastHistoryLines(LOG_PAGE_LINES, page * LOG_PAGE_LINES).join("\n");
+
+    QString text;
+    if (!readLogFile(path, text))
+        return "";
+
+    QStringList lines = text.split('\n');
+    if (lines.size() > 0 && lines.last().isEmpty())
+        lines.removeLast();
+
+    int end   = lines.size() - page * LOG_PAGE_LINES;
+    int start = end - LOG_PAGE_LINES;
+    if (start < 0)
+        start = 0;
+
+    QString rValue;
+    for (int i = start; i < end; i++) {
+        rValue.append(lines[i]);
+        rValue.append('\n');
+    }
+    return rValue;
+}
+
+/* Reads a text, binary or packed log file and returns it as text */
+bool Logging::readLogFile(const QString& path, QString& text)
+{
+    QFile file(path);
+    if (!file.open(QFile::ReadOnly))
+        return false;
+
+    QByteArray data = file.readAll();
+    file.close();
+
+    if (path.endsWith(LOG_FILE_PACKED_SUFFIX)) {
+        data = qUncompress(data);
+        if (data.isEmpty())
+            return false;
+    }
+
+    if (LogBinaryWriter::isBinaryLog(data))
+        return LogBinaryWriter::decode(data, text);
+
+    text = QString::fromUtf8(data);
+    return true;
+}
+
+/* Packs a file of a past day and removes the original, returns the path of the packed file */
+QString Logging::compressLogFile(const QString& path)
+{
+    QFile file(path);
+    if (!file.open(QFile::ReadOnly))
+        return path;
+    QByteArray data = file.readAll();
+    file.close();
+
+    QString packedPath = path + LOG_FILE_PACKED_SUFFIX;
+    QFile   packedFile(packedPath);
+    if (!packedFile.open(QFile::WriteOnly | QFile::Truncate)) {
+        qWarning().noquote() << QString("Could not create packed log file %1").arg(packedPath);
+        return path;
+    }
+    QByteArray packed = qCompress(data, 9);
+    if (packedFile.write(packed) != packed.size()) {
+        packedFile.close();
+        packedFile.remove();
+        qWarning().noquote() << QString("Could not write packed log file %1").arg(packedPath);
+        return path;
+    }
+    packedFile.close();
+    file.remove();
+
+    qInfo().noquote() << QString("Packed log file %1 from %2 to %3 bytes").arg(path).arg(data.size()).arg(packed.size());
+    return packedPath;
+}
+
+/* Has to be called with m_internalMutex locked */
+void Logging::appendHistoryLine(const QString& line, const QString& message, qint64 timeStamp)
+{
+    int pos;
+    if (this->m_historyCount < LOG_HISTORY_LINES) {
+        pos = (this->m_historyStart + this->m_historyCount) % LOG_HISTORY_LINES;
+        this->m_historyCount++;
+    } else {
+        pos                  = this->m_historyStart;
+        this->m_historyStart = (this->m_historyStart + 1) % LOG_HISTORY_LINES;
+    }
+    this->m_historyLines[pos] = line;
+    this->m_historyTimes[pos] = timeStamp;
+
+    quint64 lineNumber = this->m_historyTotal++;
+
+    static const QRegularExpression regUser("\\b[Uu]ser \"?([^\\s\"]+)");
+    static const QRegularExpression regGame("\\b[Gg]ames? (\\d+)");
+
+    QRegularExpressionMatchIterator it = regUser.globalMatch(message);
+    while (it.hasNext())
+        this->addHistoryIndex("user=" + it.next().captured(1).toLower(), lineNumber);
+    it = regGame.globalMatch(message);
+    while (it.hasNext())
+        this->addHistoryIndex("game=" + it.next().captured(1), lineNumber);
+
+    if (this->m_historyTotal % LOG_HISTORY_LINES == 0)
+        this->removeOldHistoryIndex();
+}
+
+void Logging::addHistoryIndex(const QString& key, quint64 lineNumber)
+{
+    QVector<quint64>& lines = this->m_historyIndex[key];
+    if (lines.isEmpty() || lines.last() != lineNumber)
+        lines.append(lineNumber);
+}
+
+/* Removes the line numbers which are not in the history anymore */
+void Logging::removeOldHistoryIndex()
+{
+    quint64 oldest = this->m_historyTotal - this->m_historyCount;
+
+    QHash<QString, QVector<quint64>>::iterator it = this->m_historyIndex.begin();
+    while (it != this->m_historyIndex.end()) {
+        QVector<quint64>&          lines = it.value();
+        QVector<quint64>::iterator first = std::lower_bound(lines.begin(), lines.end(), oldest);
+        lines.erase(lines.begin(), first);
+        if (lines.isEmpty())
+            it = this->m_historyIndex.erase(it);
+        else
+            ++it;
+    }
+}
+
+/*
+ * Fills lines with the lines of the history which fit to all parts of the query, e.g.
+ * "user=name game=12 since=18:30". User and game are taken from the index, since is the time of today.
+ * Returns ERROR_CODE_WRONG_PARAMETER for an unknown part, so a typo does not show all lines.
+ */
+qint32 Logging::findLogLines(const QString& query, QStringList& lines)
+{
+    QStringList keys;
+    qint64      since = 0;
+    lines.clear();
+    foreach (QString part, query.split(' ', QString::SkipEmptyParts)) {
+        if (part.startsWith("since=")) {
+            QTime time = QTime::fromString(part.mid(6), "hh:mm");
+            if (!time.isValid())
+                return ERROR_CODE_WRONG_PARAMETER;
+            since = QDateTime(QDate::currentDate(), time).toMSecsSinceEpoch();
+        } else if (part.startsWith("user=") && part.size() > 5)
+            keys.append(part.toLower());
+        else if (part.startsWith("game=") && part.size() > 5)
+            keys.append(part);
+        else
+            return ERROR_CODE_WRONG_PARAMETER;
+    }
+
     QMutexLocker lock(&this->m_internalMutex);
 
-    QList<QString> aList = this->m_currentLogging.split("\n");
-    if (aList.last() == "")
-        aList.removeLast();
+    quint64 oldest = this->m_historyTotal - this->m_historyCount;
+
+    QVector<const QVector<quint64>*> lists;
+    foreach (const QString& key, keys) {
+        QHash<QString, QVector<quint64>>::const_iterator it = this->m_historyIndex.constFind(key);
+        if (it == this->m_historyIndex.constEnd())
+            return ERROR_CODE_SUCCESS;
+        lists.append(&it.value());
+    }
 
-    int cnt = 0;
-    if (aList.size() > numbOfLines)
-        cnt = aList.size() - numbOfLines;
+    /* without keys every line is checked for the time */
+    QVector<quint64> allLines;
+    if (lists.isEmpty()) {
+        for (quint64 i = oldest; i < this->m_historyTotal; i++)
+            allLines.append(i);
+        lists.append(&allLines);
+    }
 
-    for (; cnt < aList.size(); cnt++) {
-        std::cout << aList[cnt].toStdString() << std::endl;
+    std::sort(lists.begin(), lists.end(), [](const QVector<quint64>* a, const QVector<quint64>* b) { return a->size() < b->size(); });
+
+    const QVector<quint64>*          shortest = lists.first();
+    QVector<quint64>::const_iterator start    = std::lower_bound(shortest->begin(), shortest->end(), oldest);
+    for (; start != shortest->end(); ++start) {
+        quint64 lineNumber = *start;
+        bool    bFound     = true;
+        for (int i = 1; i < lists.size() && bFound; i++)
+            bFound = std::binary_search(lists[i]->begin(), lists[i]->end(), lineNumber);
+        if (!bFound)
+            continue;
+
+        int pos = (this->m_historyStart + int(lineNumber - oldest)) % LOG_HISTORY_LINES;
+        if (this->m_historyTimes[pos] >= since)
+            lines.append(this->m_historyLines[pos]);
     }
+    return ERROR_CODE_SUCCESS;
+}
 
-    return numbOfLines;
+/* Returns up to count lines in their order, the newest skip lines are left out */
+QStringList Logging::getLastHistoryLines(int count, int skip)
+{
+    QMutexLocker lock(&this->m_internalMutex);
+
+    QStringList rValue;
+    int         end = this->m_historyCount - skip;
+    if (count <= 0 || end <= 0)
+        return rValue;
+
+    int start = end - count;
+    if (start < 0)
+        start = 0;
+
+    rValue.reserve(end - start);
+    for (int i = start; i < end; i++)
+        rValue.append(this->m_historyLines[(this->m_historyStart + i) % LOG_HISTORY_LINES]);
+    return rValue;
 }
 
 QStringList Logging::getLogFileDates()
@@ -133,7 +419,7 @@ QStringList Logging::getLogFileDates()
     QStringList rValue;
     foreach (QString file, this->m_lastLogFiles) {
         QFileInfo info(file);
-        rValue.append(info.fileName().replace(".log", ""));
+        rValue.append(info.fileName().section('.', 0, 0));
     }
     return rValue;
 }
@@ -156,36 +442,36 @@ QString Logging::createLoggingFilePath()
 
     if (loggingPath.size() > 0) {
         loggingPath.append(QDate::currentDate().toString(LOG_FILE_DATE_FORMAT));
-        loggingPath.append(".log");
+        loggingPath.append(this->m_bBinaryFormat ? LOG_FILE_BINARY_SUFFIX : LOG_FILE_TEXT_SUFFIX);
     }
 
     return loggingPath;
 }
 
+/* Takes all messages from the ring and writes them to the file with one write */
 void Logging::slotNewLogEntries()
 {
-    while (true) {
-
-        this->m_entryListMutex.lock();
-        if (this->m_logEntries.isEmpty()) {
-            this->m_entryListMutex.unlock();
-            break;
-        }
-
-        LogEntry* entry = this->m_logEntries.first();
-        this->m_logEntries.removeFirst();
-        this->m_entryListMutex.unlock();
+    this->m_wakeupPending.storeRelease(0);
 
-        QMessageLogContext context;
-        QString            msg = qFormatLogMessage(entry->m_type, context, entry->m_message);
+    QMessageLogContext context;
+    QtMsgType          type;
+    QString            message;
+    QString            batch;
+    QByteArray         binaryBatch;
 
+    QMutexLocker lock(&this->m_internalMutex);
 
-        this->m_internalMutex.lock();
-        this->m_currentLogging.append(msg + "\n");
-        if (this->m_logFile != NULL && this->m_logFile->isOpen()) {
-            QTextStream out(this->m_logFile);
-            out << msg << "\n";
-            if (entry->m_type == QtCriticalMsg)
+    bool bFileOpen = this->m_logFile != NULL && this->m_logFile->isOpen();
+    while (this->m_logRing.pop(type, message)) {
+        QString msg = qFormatLogMessage(type, context, message);
+        batch.append(msg);
+        batch.append('\n');
+        qint64 timeStamp = QDateTime::currentMSecsSinceEpoch();
+        this->appendHistoryLine(msg, message, timeStamp);
+        if (this->m_bBinaryFormat)
+            this->m_binaryWriter.appendEntry(binaryBatch, timeStamp, type, message);
+        if (bFileOpen) {
+            if (type == QtCriticalMsg)
                 std::cout << msg.toStdString() << std::endl;
             //} else if (entry->m_type != QtDebugMsg && entry->m_type != QtInfoMsg) {
         }
@@ -195,8 +481,29 @@ void Logging::slotNewLogEntries()
 #endif
             std::cout << msg.toStdString() << std::endl;
 #endif
-        delete entry;
-        this->m_internalMutex.unlock();
+    }
+
+    quint32 dropped = this->m_logRing.takeDroppedCount();
+    if (dropped > 0) {
+        QString dropMsg = QString("Dropped %1 log messages because the log buffer was full").arg(dropped);
+        QString msg     = qFormatLogMessage(QtWarningMsg, context, dropMsg);
+        batch.append(msg);
+        batch.append('\n');
+        qint64  timeStamp = QDateTime::currentMSecsSinceEpoch();
+        this->appendHistoryLine(msg, dropMsg, timeStamp);
+        if (this->m_bBinaryFormat)
+            this->m_binaryWriter.appendEntry(binaryBatch, timeStamp, QtWarningMsg, dropMsg);
+    }
+
+    if (batch.isEmpty())
+        return;
+
+    if (bFileOpen) {
+        if (this->m_bBinaryFormat)
+            this->m_logFile->write(binaryBatch);
+        else
+            this->m_logFile->write(batch.toUtf8());
+        this->m_logFile->flush();
     }
 }
 
@@ -208,7 +515,9 @@ void Logging::slotEveryHourTimeout()
         if (this->m_logFile == NULL || this->m_logFile->fileName() != loggingPath) {
 
             this->m_internalMutex.lock();
+            QString lastLogPath;
             if (this->m_logFile != NULL) {
+                lastLogPath = this->m_logFile->fileName();
                 this->m_logFile->close();
                 delete this->m_logFile;
             }
@@ -223,13 +532,30 @@ void Logging::slotEveryHourTimeout()
             }
 
             this->m_logFile = new QFile(loggingPath);
-            if (!this->m_logFile->open(QFile::ReadWrite | QFile::Text | QFile::Append)) {
+            QFile::OpenMode mode = QFile::ReadWrite | QFile::Append;
+            if (!this->m_bBinaryFormat)
+                mode |= QFile::Text;
+            if (!this->m_logFile->open(mode)) {
                 this->m_internalMutex.unlock();
                 QString error = QString("Error creating logfile %1").arg(loggingPath);
                 std::cout << error.toStdString() << std::endl;
                 return;
             }
+            if (this->m_bBinaryFormat) {
+                if (this->m_logFile->size() == 0)
+                    this->m_logFile->write(LOG_BINARY_HEADER);
+                this->m_binaryWriter.reset();
+            }
             this->m_internalMutex.unlock();
+
+            if (lastLogPath.size() > 0) {
+                QString packedPath = this->compressLogFile(lastLogPath);
+                this->m_internalMutex.lock();
+                int index = this->m_lastLogFiles.indexOf(lastLogPath);
+                if (index >= 0)
+                    this->m_lastLogFiles[index] = packedPath;
+                this->m_internalMutex.unlock();
+            }
             qInfo().noquote() << QString("Current Loggin Path = %1").arg(loggingPath);
 #ifdef Q_OS_UNIX
             QFileInfo info(loggingPath);
@@ -249,10 +575,10 @@ void Logging::slotEveryHourTimeout()
     /* Remove all old log files */
     for (int i = this->m_lastLogFiles.size() - 1; i >= 0; i--) {
         QFileInfo file(this->m_lastLogFiles[i]);
-        QDate     fileDate = QDate::fromString(file.fileName().replace(".log", ""), LOG_FILE_DATE_FORMAT);
+        QDate     fileDate = getLogFileDate(file.fileName());
         if (fileDate.isValid() && fileDate.addDays(MAX_DAYS_LOG_FILES) < QDate::currentDate()) {
             if (!QFile::remove(file.absoluteFilePath()))
-                qWarning().noquote() << QString("Could not remove file: %1.log").arg(file.absoluteFilePath());
+                qWarning().noquote() << QString("Could not remove file: %1").arg(file.absoluteFilePath());
             else
                 this->m_lastLogFiles.removeAt(i);
         }
@@ -19,26 +19,66 @@
 #ifndef LOGGING_H
 #define LOGGING_H
 
+#include <QtCore/QAtomicInteger>
 #include <QtCore/QFile>
+#include <QtCore/QHash>
 #include <QtCore/QList>
 #include <QtCore/QMutex>
 #include <QtCore/QObject>
 #include <QtCore/QTimer>
+#include <QtCore/QVector>
 
 #ifdef STAMORGA_APP
 #include "../../Common/General/backgroundworker.h"
+#include "../../Common/General/logbinaryformat.h"
 #else
 #include "../Common/General/backgroundworker.h"
+#include "../Common/General/logbinaryformat.h"
 #endif
 
 //void logMyMessageLogginOutPut(QtMsgType type, const QMessageLogContext& context, const QString& msg);
 
+// clang-format off
+#define LOG_RING_SIZE           4096                        /* has to be a power of two */
+#define LOG_RING_DEBUG_LIMIT    (LOG_RING_SIZE * 3 / 4)     /* debug messages are dropped above this fill level */
+
+#if defined(Q_OS_ANDROID) || defined(Q_OS_IOS)
+#define LOG_HISTORY_LINES       1000
+#else
+#define LOG_HISTORY_LINES       20000
+#endif
+#define LOG_PAGE_LINES          200
+// clang-format on
+
 struct LogEntry {
-    QtMsgType m_type;
+    QAtomicInteger<quint32> m_sequence;
+    QtMsgType               m_type;
     //    QMessageLogContext m_context;
     QString m_message;
 };
 
+/*
+ * Bounded ring for log messages, every thread can push without a lock, only the logging
+ * thread pops. When it is full new messages are dropped and counted, debug messages are
+ * already dropped when it is filled above LOG_RING_DEBUG_LIMIT to keep room for the others.
+ */
+class LogRingBuffer
+{
+public:
+    LogRingBuffer();
+
+    bool push(QtMsgType type, const QString& msg);
+    bool pop(QtMsgType& type, QString& msg);
+
+    quint32 takeDroppedCount() { return this->m_dropped.fetchAndStoreOrdered(0); }
+
+private:
+    LogEntry                m_entries[LOG_RING_SIZE];
+    QAtomicInteger<quint32> m_writePos;
+    QAtomicInteger<quint32> m_readPos;
+    QAtomicInteger<quint32> m_dropped;
+};
+
 class Logging : public BackgroundWorker
 {
     Q_OBJECT
@@ -47,23 +87,21 @@ public:
 
     void initialize();
 
+    /* has to be set before starting, the file of the day is then written in the binary format */
+    void setBinaryFormat(bool binary) { this->m_bBinaryFormat = binary; }
+
     void addNewEntry(QtMsgType type, /*const QMessageLogContext context,*/ const QString& msg);
 
     int showLoggingInfo(quint16 numbOfLines);
 
-    QString getCurrentLoggingList(int index)
-    {
-        if (index < this->m_lastLogFiles.size()) {
-            QFile file(this->m_lastLogFiles[index]);
-            if (file.open(QFile::ReadOnly))
-                return QString(file.readAll());
-        }
-
-        return this->m_currentLogging;
-    }
+    QString getCurrentLoggingList(int index, int page = 0);
 
     QStringList getLogFileDates();
 
+    qint32 findLogLines(const QString& query, QStringList& lines);
+
+    static bool readLogFile(const QString& path, QString& text);
+
     void terminate();
 
 
@@ -78,16 +116,32 @@ protected:
     int DoBackgroundWork();
 
 private:
-    QFile*           m_logFile;
-    QList<LogEntry*> m_logEntries;
-    QMutex           m_internalMutex;
-    QMutex           m_entryListMutex;
-    QString          m_currentLogging;
-    QTimer*          m_hourTimer;
+    QFile*          m_logFile;
+    bool            m_bBinaryFormat;
+    LogBinaryWriter m_binaryWriter;
+    LogRingBuffer   m_logRing;
+    QAtomicInt      m_wakeupPending;
+    QMutex          m_internalMutex;
+    QTimer*         m_hourTimer;
+
+    /* last formatted lines, oldest one at m_historyStart */
+    QVector<QString> m_historyLines;
+    QVector<qint64>  m_historyTimes;
+    int              m_historyStart;
+    int              m_historyCount;
+    quint64          m_historyTotal;
+
+    /* line numbers of the history by key, e.g. "user=name" or "game=12", in ascending order */
+    QHash<QString, QVector<quint64>> m_historyIndex;
 
     QList<QString> m_lastLogFiles;
 
     QString createLoggingFilePath();
+    QString compressLogFile(const QString& path);
+    void appendHistoryLine(const QString& line, const QString& message, qint64 timeStamp);
+    void addHistoryIndex(const QString& key, quint64 lineNumber);
+    void removeOldHistoryIndex();
+    QStringList getLastHistoryLines(int count, int skip = 0);
 };
 
 
@@ -24,7 +24,7 @@
 
 
 #define MIN_PAYLOAD_SIZE sizeof(msg_Header)
-//#define MAX_PAYLOAD_SIZE    512
+#define MAX_PAYLOAD_SIZE (4 * 1024 * 1024)
 
 
 MessageBuffer::MessageBuffer()
@@ -54,10 +54,12 @@ MessageProtocol* MessageBuffer::GetNextMessage()
 
     payLoadLength += MIN_PAYLOAD_SIZE; // MinSize
 
-    //    if (payLoadLength > MAX_PAYLOAD_SIZE) {
-    //        this->m_DataBuffer.clear();
-    //        return NULL;
-    //    }
+    /* The buffer does not start with a header, drop it so the next datagram starts again */
+    quint32 version = qFromLittleEndian(pHead->m_version) & MSG_HEADER_VERSION_MASK;
+    if (payLoadLength > MAX_PAYLOAD_SIZE || version < MSG_HEADER_VERSION_START) {
+        this->m_DataBuffer.clear();
+        return NULL;
+    }
 
     if (payLoadLength > (uint)this->m_DataBuffer.length()) // not yet received everything
         return NULL;
@@ -69,3 +71,9 @@ MessageProtocol* MessageBuffer::GetNextMessage()
 
     return msg;
 }
+
+/* Drops an incomplete message, e.g. when a datagram of it got lost and it is requested again */
+void MessageBuffer::Reset()
+{
+    this->m_DataBuffer.clear();
+}
@@ -34,6 +34,8 @@ public:
 
     MessageProtocol *GetNextMessage();
 
+    void Reset();
+
 private:
     QByteArray m_DataBuffer;
 };
@@ -44,6 +44,9 @@ enum OP_CODE_CMD_REQ {
     REQ_CHANGE_MEETING_INFO = 0x00100001,
     REQ_GET_MEETING_INFO    = 0x00100002,
     REQ_ACCEPT_MEETING      = 0x00100004,
+
+    REQ_SUBSCRIBE_PUSH = 0x00200001,
+    REQ_ACK_PUSH       = 0x00200002,
 };
 
 enum OP_CODE_CMD_RES {
@@ -71,6 +74,9 @@ enum OP_CODE_CMD_RES {
     ACK_GET_MEETING_INFO    = 0x10100002,
     ACK_ACCEPT_MEETING      = 0x10100004,
 
+    ACK_SUBSCRIBE_PUSH = 0x10200001,
+    PUSH_NOTIFY_CHANGE = 0x10200002, /* send from server without request, client answers with REQ_ACK_PUSH */
+
     ACK_NOT_LOGGED_IN = 0x1F00FFFF,
 };
 
@@ -0,0 +1,171 @@
+/*
+*	This file is part of StamOrga
+*   Copyright (C) 2017 Markus Schneider
+*
+*	This program is free software; you can redistribute it and/or modify
+*   it under the terms of the GNU General Public License as published by
+*   the Free Software Foundation; either version 3 of the License, or
+*   (at your option) any later version.
+*
+*	StamOrga is distributed in the hope that it will be useful,
+*    but WITHOUT ANY WARRANTY; without even the implied warranty of
+*    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+*    GNU General Public License for more details.
+
+*    You should have received a copy of the GNU General Public License
+*    along with StamOrga.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include <algorithm>
+#include <cstring>
+
+#include <QtCore/QDebug>
+#include <QtCore/QElapsedTimer>
+
+#include "messagecompression.h"
+
+static bool lengthGreaterThan(const QByteArray& s1, const QByteArray& s2)
+{
+    return s1.size() > s2.size();
+}
+
+/*
+ * Create the answer message, compress it when the requester understands it and it pays off
+ */
+MessageProtocol* MessageCompression::createMessage(const quint32 index, QByteArray& data,
+                                                   const QStringList& dictionary, const quint32 version)
+{
+    if (version < MSG_HEADER_VERSION_COMPRESS || data.size() <= COMPRESS_THRESHOLD_SIZE)
+        return new MessageProtocol(index, data);
+
+    QElapsedTimer timer;
+    timer.start();
+
+    QByteArray compressed;
+    if (!MessageCompression::compress(data, dictionary, compressed))
+        return new MessageProtocol(index, data);
+
+    qint64 usec = timer.nsecsElapsed() / 1000;
+    qInfo().noquote() << QString("Compressed message 0x%1 from %2 to %3 bytes in %4 us")
+                             .arg(QString::number(index, 16))
+                             .arg(data.size())
+                             .arg(compressed.size())
+                             .arg(usec);
+
+    MessageProtocol* msg = new MessageProtocol(index, compressed);
+    msg->setFlags(MSG_HEADER_FLAG_COMPRESSED);
+    return msg;
+}
+
+bool MessageCompression::compress(const QByteArray& data, const QStringList& dictionary, QByteArray& compressed)
+{
+    QList<QByteArray> lDict;
+    foreach (QString entry, dictionary) {
+        QByteArray utf8 = entry.toUtf8();
+        if (utf8.size() < COMPRESS_DICT_MIN_LENGTH || utf8.size() > 0xFF || lDict.contains(utf8))
+            continue;
+        lDict.append(utf8);
+        if (lDict.size() >= COMPRESS_DICT_MAX_ENTRIES)
+            break;
+    }
+    /* longest first, so a name is not replaced by a shorter prefix of it */
+    std::sort(lDict.begin(), lDict.end(), lengthGreaterThan);
+
+    QByteArray header;
+    header.append(char(lDict.size()));
+    foreach (QByteArray entry, lDict) {
+        header.append(char(entry.size()));
+        header.append(entry);
+    }
+
+    QByteArray  body;
+    const char* pData = data.constData();
+    int         size  = data.size();
+    body.reserve(size);
+    for (int i = 0; i < size;) {
+        if (quint8(pData[i]) == COMPRESS_DICT_ESCAPE) {
+            body.append(char(COMPRESS_DICT_ESCAPE));
+            body.append(char(COMPRESS_DICT_ESCAPE_LIT));
+            i++;
+            continue;
+        }
+        int found = -1;
+        for (int j = 0; j < lDict.size(); j++) {
+            const QByteArray& entry = lDict.at(j);
+            if (entry.size() <= size - i && memcmp(pData + i, entry.constData(), entry.size()) == 0) {
+                found = j;
+                break;
+            }
+        }
+        if (found >= 0) {
+            body.append(char(COMPRESS_DICT_ESCAPE));
+            body.append(char(found));
+            i += lDict.at(found).size();
+        } else
+            body.append(pData[i++]);
+    }
+
+    compressed = header + qCompress(body);
+    if (compressed.size() >= data.size())
+        return false;
+
+    return true;
+}
+
+bool MessageCompression::uncompress(const char* pData, const quint32 size, QByteArray& data)
+{
+    if (pData == NULL || size < 1)
+        return false;
+
+    QList<QByteArray> lDict;
+    quint32           offset    = 1;
+    quint8            dictCount = quint8(pData[0]);
+    for (quint8 i = 0; i < dictCount; i++) {
+        if (offset >= size)
+            return false;
+        quint8 entrySize = quint8(pData[offset++]);
+        if (offset + entrySize > size)
+            return false;
+        lDict.append(QByteArray(pData + offset, entrySize));
+        offset += entrySize;
+    }
+
+    QByteArray body = qUncompress((const uchar*)(pData + offset), size - offset);
+    if (body.isEmpty())
+        return false;
+
+    data.clear();
+    data.reserve(body.size() * 2);
+    const char* pBody = body.constData();
+    for (int i = 0; i < body.size(); i++) {
+        if (quint8(pBody[i]) != COMPRESS_DICT_ESCAPE) {
+            data.append(pBody[i]);
+            continue;
+        }
+        if (++i >= body.size())
+            return false;
+        quint8 entry = quint8(pBody[i]);
+        if (entry == COMPRESS_DICT_ESCAPE_LIT)
+            data.append(char(COMPRESS_DICT_ESCAPE));
+        else if (entry < lDict.size())
+            data.append(lDict.at(entry));
+        else
+            return false;
+    }
+
+    return true;
+}
+
+/*
+ * Returns a new uncompressed message or NULL when the data was corrupt, msg is not deleted
+ */
+MessageProtocol* MessageCompression::uncompressMessage(MessageProtocol* msg)
+{
+    QByteArray data;
+    if (!MessageCompression::uncompress(msg->getPointerToData(), msg->getDataLength(), data))
+        return NULL;
+
+    MessageProtocol* plain = new MessageProtocol(msg->getIndex(), data);
+    plain->setRequestId(msg->getRequestId());
+    return plain;
+}
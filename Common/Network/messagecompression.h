@@ -0,0 +1,55 @@
+/*
+*	This file is part of StamOrga
+*   Copyright (C) 2017 Markus Schneider
+*
+*	This program is free software; you can redistribute it and/or modify
+*   it under the terms of the GNU General Public License as published by
+*   the Free Software Foundation; either version 3 of the License, or
+*   (at your option) any later version.
+*
+*	StamOrga is distributed in the hope that it will be useful,
+*    but WITHOUT ANY WARRANTY; without even the implied warranty of
+*    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+*    GNU General Public License for more details.
+
+*    You should have received a copy of the GNU General Public License
+*    along with StamOrga.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#ifndef MESSAGECOMPRESSION_H
+#define MESSAGECOMPRESSION_H
+
+#include <QtCore/QByteArray>
+#include <QtCore/QStringList>
+
+#include "messageprotocol.h"
+
+// clang-format off
+#define COMPRESS_THRESHOLD_SIZE     (2 * MAX_DATAGRAMM_SIZE)
+#define COMPRESS_DICT_ESCAPE        0x1B
+#define COMPRESS_DICT_ESCAPE_LIT    0xFF
+#define COMPRESS_DICT_MAX_ENTRIES   0xFE
+#define COMPRESS_DICT_MIN_LENGTH    3
+// clang-format on
+
+/* Compressed payload
+ * 0    quint8      dictCount       1
+ * 1    quint8      sizeEntry1      1
+ * 2    QString     entry1          X
+ * ...
+ * Y    QByteArray  qCompress(data with entries replaced by ESCAPE + index)
+ */
+
+class MessageCompression
+{
+public:
+    static MessageProtocol* createMessage(const quint32 index, QByteArray& data,
+                                          const QStringList& dictionary, const quint32 version);
+
+    static bool compress(const QByteArray& data, const QStringList& dictionary, QByteArray& compressed);
+    static bool uncompress(const char* pData, const quint32 size, QByteArray& data);
+
+    static MessageProtocol* uncompressMessage(MessageProtocol* msg);
+};
+
+#endif // MESSAGECOMPRESSION_H
@@ -38,9 +38,15 @@ struct msg_Header {
 #define MSG_HEADER_VERSION_START        0x1
 #define MSG_HEADER_VERSION_PASSWORD     0x2
 #define MSG_HEADER_VERSION_GAME_LIST    0x3
+#define MSG_HEADER_VERSION_COMPRESS     0x4
+#define MSG_HEADER_VERSION_REQUEST_ID   0x5
+
+#define MSG_HEADER_VERSION_MASK         0x0000FFFF
+#define MSG_HEADER_FLAG_MASK            0xFFFF0000
+#define MSG_HEADER_FLAG_COMPRESSED      0x00010000
 // clang-format on
 
-#define MSG_HEADER_VERSION MSG_HEADER_VERSION_GAME_LIST
+#define MSG_HEADER_VERSION MSG_HEADER_VERSION_REQUEST_ID
 
 #define MAX_DATAGRAMM_SIZE 512
 
@@ -58,7 +64,19 @@ public:
     quint32 getTimeStamp() { return qFromLittleEndian(this->m_pHead->m_timestamp); }
     quint32 getIndex() { return qFromLittleEndian(this->m_pHead->m_index); }
     quint32 getDataLength() { return qFromLittleEndian(this->m_pHead->m_length); }
-    quint32 getVersion() { return qFromLittleEndian(this->m_pHead->m_version); }
+    quint32 getVersion() { return qFromLittleEndian(this->m_pHead->m_version) & MSG_HEADER_VERSION_MASK; }
+    quint32 getFlags() { return qFromLittleEndian(this->m_pHead->m_version) & MSG_HEADER_FLAG_MASK; }
+    bool    isCompressed() { return (this->getFlags() & MSG_HEADER_FLAG_COMPRESSED) > 0; }
+
+    /* Since MSG_HEADER_VERSION_REQUEST_ID the timestamp carries the request id, the answer returns it */
+    quint32 getRequestId() { return this->getTimeStamp(); }
+    void setRequestId(const quint32 id) { this->m_pHead->m_timestamp = qToLittleEndian(id); }
+
+    void setFlags(const quint32 flags)
+    {
+        quint32 value            = this->getVersion() | (flags & MSG_HEADER_FLAG_MASK);
+        this->m_pHead->m_version = qToLittleEndian(value);
+    }
 
     quint32     getNetworkSize() { return this->m_Data.size(); }
     const char* getNetworkProtocol() { return this->m_Data.constData(); }
@@ -204,6 +204,114 @@ int Games::addNewGame(QString home, QString away, qint64 timestamp, quint8 sInde
     return newIndex;
 }
 
+/*
+ * Applies all changes of one online reading round together. The ini file is written once,
+ * the list is sorted once and the last update time changes only once, so clients do not
+ * have to reload the games for every single change.
+ */
+int Games::updateGames(QList<GameUpdate>& updates)
+{
+    bool   bSort    = false;
+    int    nChanged = 0;
+    qint64 now      = QDateTime::currentMSecsSinceEpoch();
+
+    for (int i = 0; i < updates.size(); i++) {
+        GameUpdate& update = updates[i];
+        update.m_index     = ERROR_CODE_COMMON;
+        update.m_bChanged  = false;
+
+        if (update.m_saisonIndex == 0 || update.m_competition == NO_COMPETITION) {
+            qWarning().noquote() << "Could not add game because saisonIndex or competition were zero";
+            continue;
+        }
+
+        if (update.m_saison == 0) {
+            QDate date = QDateTime::fromMSecsSinceEpoch(update.m_timestamp).date();
+            if (date.month() >= 6)
+                update.m_saison = date.year();
+            else
+                update.m_saison = date.year() - 1;
+        }
+
+        qint64 lastUpdate = update.m_lastUpdate;
+        if (lastUpdate == 0)
+            lastUpdate = QDateTime::currentMSecsSinceEpoch();
+
+        GamesPlay* pGame = this->gameExists(update.m_saisonIndex, update.m_competition, update.m_saison, update.m_timestamp);
+        if (pGame == NULL) {
+            int newIndex = this->getNextInternalIndex();
+            pGame        = new GamesPlay(update.m_home, update.m_away, update.m_timestamp, update.m_saisonIndex, update.m_score,
+                                  update.m_competition, update.m_saison, newIndex, now, false);
+            this->addNewGamesPlay(pGame, false);
+            qInfo().noquote() << QString("Added new game: %1").arg(update.m_home + " : " + update.m_away);
+
+            update.m_index    = newIndex;
+            update.m_bChanged = true;
+            bSort             = true;
+            nChanged++;
+            continue;
+        }
+
+        if (pGame->m_lastUpdate > lastUpdate) {
+            update.m_index = ERROR_CODE_IN_PAST;
+            continue;
+        }
+
+        QMutexLocker locker(&this->m_mInternalInfoMutex);
+
+        if (pGame->m_itemName != update.m_home) {
+            pGame->m_itemName = update.m_home;
+            update.m_bChanged = true;
+        }
+        if (pGame->m_away != update.m_away) {
+            pGame->m_away     = update.m_away;
+            update.m_bChanged = true;
+        }
+        if (pGame->m_timestamp != update.m_timestamp) {
+            pGame->m_timestamp = update.m_timestamp;
+            update.m_bChanged  = true;
+            bSort              = true;
+        }
+        if (pGame->m_score != update.m_score && update.m_score.size() > 0) {
+            pGame->m_score    = update.m_score;
+            update.m_bChanged = true;
+        }
+        if (pGame->m_competition != update.m_competition) {
+            pGame->m_competition = update.m_competition;
+            update.m_bChanged    = true;
+        }
+        if (pGame->m_saisonIndex != update.m_saisonIndex) {
+            pGame->m_saisonIndex = update.m_saisonIndex;
+            update.m_bChanged    = true;
+        }
+
+        if (update.m_bChanged) {
+            pGame->m_lastUpdate = now;
+            nChanged++;
+        }
+        update.m_index = pGame->m_index;
+    }
+
+    if (nChanged == 0)
+        return 0;
+
+    if (bSort)
+        this->sortGamesListByTime();
+
+    /* changed games and the list get the same time, so apps see them in the next diff update */
+    this->m_mInternalInfoMutex.lock();
+    this->saveGamesList();
+    this->m_mInternalInfoMutex.unlock();
+    this->setNewUpdateTime(now);
+
+    this->m_mConfigIniMutex.lock();
+    this->m_pConfigSettings->sync();
+    this->m_mConfigIniMutex.unlock();
+
+    qInfo().noquote() << QString("Updated %1 of %2 games together").arg(nChanged).arg(updates.size());
+    return nChanged;
+}
+
 int Games::showAllGames()
 {
     QMutexLocker locker(&this->m_mInternalInfoMutex);
@@ -251,6 +359,14 @@ int Games::changeScheduledValue(const quint32 gameIndex, const quint32 fixedTime
 }
 
 void Games::saveCurrentInteralList()
+{
+    this->saveGamesList();
+
+    this->setNewUpdateTime();
+}
+
+/* Writes the list without setting a new update time, updateGames sets its own time */
+void Games::saveGamesList()
 {
     this->m_mConfigIniMutex.lock();
 
@@ -283,8 +399,6 @@ void Games::saveCurrentInteralList()
 
     this->m_mConfigIniMutex.unlock();
 
-    this->setNewUpdateTime();
-
     qDebug().noquote() << QString("saved actual Games List with %1 entries").arg(this->getNumberOfInternalList());
 }
 
@@ -56,6 +56,20 @@ public:
     }
 };
 
+/* One change of a game for Games::updateGames, m_index and m_bChanged are the result */
+struct GameUpdate {
+    QString          m_home;
+    QString          m_away;
+    qint64           m_timestamp;
+    quint8           m_saisonIndex;
+    QString          m_score;
+    CompetitionIndex m_competition;
+    quint16          m_saison;
+    qint64           m_lastUpdate;
+    int              m_index;
+    bool             m_bChanged;
+};
+
 // clang-format off
 #define PLAY_AWAY           "away"
 #define PLAY_SAISON_INDEX   "sIndex"
@@ -75,6 +89,7 @@ public:
     int addNewGame(QString home, QString away, qint64 timestamp,
                    quint8 sIndex, QString score, CompetitionIndex comp,
                    quint16 season = 0, qint64 lastUpdate = 0);
+    int updateGames(QList<GameUpdate>& updates);
     int showAllGames();
 
     int changeScheduledValue(const quint32 gameIndex, const quint32 fixedTime);
@@ -87,6 +102,7 @@ public:
 
 private:
     void saveCurrentInteralList() override;
+    void saveGamesList();
 
     //    bool addNewGamesPlay(QString home, QString away, qint64 timestamp, quint8 sIndex, QString score, CompetitionIndex comp, quint16 season, quint32 index, bool checkGame = true);
     //    void addNewGamesPlay(QString home, QString away, qint64 timestamp, quint8 sIndex, QString score, CompetitionIndex comp, quint16 season, quint32 index, QList<ConfigItem*>* pList);
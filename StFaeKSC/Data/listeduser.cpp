@@ -137,6 +137,74 @@ int ListedUser::addNewUser(const QString& name, const QString& password, quint32
     return newIndex;
 }
 
+/*
+ * Adds or changes all users of a list together, the ini file is only written once at the end.
+ * New users get their name as password like with addNewUser.
+ */
+int ListedUser::updateUsers(QList<UserUpdate>& updates)
+{
+    int nChanged = 0;
+
+    for (int i = 0; i < updates.size(); i++) {
+        UserUpdate& update = updates[i];
+        update.m_index     = ERROR_CODE_COMMON;
+        update.m_bChanged  = false;
+
+        if (update.m_name.length() < MIN_SIZE_USERNAME) {
+            CONSOLE_WARNING(QString("Name \"%1\" is too short").arg(update.m_name));
+            continue;
+        }
+
+        UserLogin* pLogin = NULL;
+        this->m_mInternalInfoMutex.lock();
+        for (int j = 0; j < this->getNumberOfInternalList(); j++) {
+            UserLogin* pItem = (UserLogin*)(this->getItemFromArrayIndex(j));
+            if (pItem != NULL && pItem->m_itemName == update.m_name) {
+                pLogin = pItem;
+                break;
+            }
+        }
+        if (pLogin != NULL) {
+            if (pLogin->m_properties != update.m_properties) {
+                pLogin->m_properties = update.m_properties;
+                update.m_bChanged    = true;
+                nChanged++;
+            }
+            update.m_index = pLogin->m_index;
+        }
+        this->m_mInternalInfoMutex.unlock();
+
+        if (pLogin != NULL)
+            continue;
+
+        int     newIndex     = this->getNextInternalIndex();
+        qint64  timestamp    = QDateTime::currentDateTime().toMSecsSinceEpoch();
+        QString salt         = createRandomString(8);
+        QString hashPassword = this->createHashPassword(update.m_name, salt);
+
+        this->addNewUserLogin(update.m_name, timestamp, newIndex, hashPassword, salt, update.m_properties, "", false);
+        qInfo() << QString("Added new user: %1").arg(update.m_name);
+
+        update.m_index    = newIndex;
+        update.m_bChanged = true;
+        nChanged++;
+    }
+
+    if (nChanged == 0)
+        return 0;
+
+    this->m_mInternalInfoMutex.lock();
+    this->saveCurrentInteralList();
+    this->m_mInternalInfoMutex.unlock();
+
+    this->m_mConfigIniMutex.lock();
+    this->m_pConfigSettings->sync();
+    this->m_mConfigIniMutex.unlock();
+
+    qInfo().noquote() << QString("Updated %1 of %2 users together").arg(nChanged).arg(updates.size());
+    return nChanged;
+}
+
 int ListedUser::showAllUsers()
 {
     QMutexLocker locker(&this->m_mInternalInfoMutex);
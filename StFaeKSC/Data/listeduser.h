@@ -36,6 +36,14 @@ public:
     quint32 m_properties;
 };
 
+/* One user for ListedUser::updateUsers, m_index and m_bChanged are the result */
+struct UserUpdate {
+    QString m_name;
+    quint32 m_properties;
+    int     m_index;
+    bool    m_bChanged;
+};
+
 // clang-format off
 #define LOGIN_PASSWORD      "password"
 #define LOGIN_SALT          "salt"
@@ -57,6 +65,7 @@ public:
     ~ListedUser();
 
     int addNewUser(const QString& name, const QString& password = "", quint32 props = DEFAULT_LOGIN_PROPS);
+    int updateUsers(QList<UserUpdate>& updates);
     int showAllUsers();
 
     bool userCheckPassword(QString name, QString passw);
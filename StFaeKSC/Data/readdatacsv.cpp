@@ -17,6 +17,7 @@
 */
 
 #include <QtCore/QDateTime>
+#include <QtCore/QElapsedTimer>
 #include <QtCore/QFile>
 
 
@@ -35,6 +36,10 @@ enum CSV_IMPORT_GROUP {
     GAME    = 2
 };
 
+/*
+ * The whole file is parsed and checked first, afterwards all games and users are added
+ * together. So a broken file changes nothing and the lists are only sorted and saved once.
+ */
 int ReadDataCSV::readNewCSVData(QString path)
 {
     QFile csvFile(path);
@@ -49,102 +54,150 @@ int ReadDataCSV::readNewCSVData(QString path)
         return -1;
     }
 
-    CSV_IMPORT_GROUP actGroup = CSV_IMPORT_GROUP::NOTHING;
-    while (!csvFile.atEnd()) {
-        QByteArray aline = csvFile.readLine();
-        QString    line(aline);
+    QElapsedTimer timer;
+    timer.start();
+
+    this->m_lGames.clear();
+    this->m_lUsers.clear();
+
+    int    errorLines;
+    uchar* pMapped = csvFile.size() > 0 ? csvFile.map(0, csvFile.size()) : NULL;
+    if (pMapped != NULL) {
+        errorLines = this->parseCSVData(QByteArray::fromRawData((const char*)pMapped, csvFile.size()));
+        csvFile.unmap(pMapped);
+    } else
+        errorLines = this->parseCSVData(csvFile.readAll());
+    csvFile.close();
+
+    if (errorLines > 0) {
+        CONSOLE_CRITICAL(QString("Did not import anything from %1 because of %2 wrong lines").arg(path).arg(errorLines));
+        return ERROR_CODE_WRONG_PARAMETER;
+    }
+
+    qint64 parseTime = timer.elapsed();
+
+    int nGames = 0, nUsers = 0;
+    if (this->m_lGames.size() > 0)
+        nGames = this->m_pGlobalData->m_GamesList.updateGames(this->m_lGames);
+    if (this->m_lUsers.size() > 0)
+        nUsers = this->m_pGlobalData->m_UserList.updateUsers(this->m_lUsers);
+
+    CONSOLE_INFO(QString("Imported %1: %2 of %3 games and %4 of %5 users changed, parsing %6ms, total %7ms")
+                     .arg(path)
+                     .arg(nGames)
+                     .arg(this->m_lGames.size())
+                     .arg(nUsers)
+                     .arg(this->m_lUsers.size())
+                     .arg(parseTime)
+                     .arg(timer.elapsed()));
+
+    this->m_lGames.clear();
+    this->m_lUsers.clear();
+    return ERROR_CODE_SUCCESS;
+}
+
+/* Returns the number of wrong lines */
+int ReadDataCSV::parseCSVData(const QByteArray& data)
+{
+    CSV_IMPORT_GROUP actGroup   = CSV_IMPORT_GROUP::NOTHING;
+    int              errorLines = 0;
+    int              lineNumber = 0;
+    int              start      = 0;
+
+    while (start < data.size()) {
+        int end = data.indexOf('\n', start);
+        if (end < 0)
+            end = data.size();
+
+        QByteArray line = data.mid(start, end - start).trimmed();
+        start           = end + 1;
+        lineNumber++;
 
-        if (line.trimmed() == "GAMES")
+        if (line.isEmpty())
+            continue;
+
+        if (line == "GAMES") {
             actGroup = CSV_IMPORT_GROUP::GAME;
-        else if (line.trimmed() == "USER")
+            continue;
+        } else if (line == "USER") {
             actGroup = CSV_IMPORT_GROUP::USER;
-        else {
-            QStringList lline = line.trimmed().split(";");
+            continue;
+        }
 
-            switch (actGroup) {
-            case CSV_IMPORT_GROUP::GAME:
-                this->readNewGameData(lline);
-                break;
+        int rValue = ERROR_CODE_SUCCESS;
+        switch (actGroup) {
+        case CSV_IMPORT_GROUP::GAME:
+            rValue = this->readNewGameData(line.split(';'));
+            break;
 
-            case CSV_IMPORT_GROUP::USER:
-                this->readNewUserData(lline);
-                break;
+        case CSV_IMPORT_GROUP::USER:
+            rValue = this->readNewUserData(line.split(';'));
+            break;
+
+        default:
+            break;
+        }
 
-            default:
-                break;
-            }
+        if (rValue != ERROR_CODE_SUCCESS) {
+            qWarning().noquote() << QString("Wrong data in line %1: %2").arg(lineNumber).arg(QString::fromUtf8(line));
+            errorLines++;
         }
     }
-    return 0;
+
+    return errorLines;
 }
 
-int ReadDataCSV::readNewGameData(QStringList line)
+int ReadDataCSV::readNewGameData(const QList<QByteArray>& line)
 {
-    bool   ok;
-    quint8 sIndex = 0;
-    if (line.size() > 0) {
-        sIndex = line.value(0).toUShort(&ok);
-        if (!ok) {
-            qWarning().noquote() << QString("Could not read %1 as integer value").arg(line.value(0));
-            return ERROR_CODE_COMMON;
-        }
-    }
+    bool       ok;
+    GameUpdate update;
 
-    CompetitionIndex competition = NO_COMPETITION;
-    if (line.size() > 1) {
-        competition = CompetitionIndex(line.value(1).toUInt(&ok));
-        if (!ok) {
-            qWarning().noquote() << QString("Could not read %1 as integer value").arg(line.value(1));
-            return ERROR_CODE_COMMON;
-        }
+    update.m_saisonIndex = line.value(0).toUShort(&ok);
+    if (!ok || update.m_saisonIndex == 0) {
+        qWarning().noquote() << QString("Could not read %1 as game index").arg(QString(line.value(0)));
+        return ERROR_CODE_COMMON;
     }
 
-    qint64 datetime = 0;
-    if (line.size() > 2) {
-        QDateTime time = QDateTime::fromString(line.value(2), "dd.MM.yyyy hh:mm");
-        datetime       = time.toMSecsSinceEpoch();
+    update.m_competition = CompetitionIndex(line.value(1).toUInt(&ok));
+    if (!ok || update.m_competition == NO_COMPETITION) {
+        qWarning().noquote() << QString("Could not read %1 as competition").arg(QString(line.value(1)));
+        return ERROR_CODE_COMMON;
     }
 
-    QString home;
-    if (line.size() > 3)
-        home = line.value(3);
-
-    QString away;
-    if (line.size() > 4)
-        away = line.value(4);
-
-    QString score;
-    if (line.size() > 5)
-        score = line.value(5);
+    QDateTime time = QDateTime::fromString(QString(line.value(2)), "dd.MM.yyyy hh:mm");
+    if (!time.isValid()) {
+        qWarning().noquote() << QString("Could not read %1 as date").arg(QString(line.value(2)));
+        return ERROR_CODE_COMMON;
+    }
 
-    this->m_pGlobalData->m_GamesList.addNewGame(home, away, datetime, sIndex, score, competition);
-    this->m_pGlobalData->m_GamesList.sortGamesListByTime();
+    update.m_timestamp  = time.toMSecsSinceEpoch();
+    update.m_home       = QString::fromUtf8(line.value(3));
+    update.m_away       = QString::fromUtf8(line.value(4));
+    update.m_score      = QString::fromUtf8(line.value(5));
+    update.m_saison     = 0;
+    update.m_lastUpdate = 0;
+    update.m_index      = 0;
+    update.m_bChanged   = false;
 
+    this->m_lGames.append(update);
     return ERROR_CODE_SUCCESS;
 }
 
-int ReadDataCSV::readNewUserData(QStringList line)
+int ReadDataCSV::readNewUserData(const QList<QByteArray>& line)
 {
-    if (line.length() < 2)
-        return -1;
+    if (line.size() < 2)
+        return ERROR_CODE_COMMON;
 
-    bool    ok;
-    QString name = line.at(0);
-    quint32 prop = line.at(1).toInt(&ok, 16);
+    bool       ok;
+    UserUpdate update;
+    update.m_name       = QString::fromUtf8(line.at(0));
+    update.m_properties = line.at(1).toUInt(&ok, 16);
     if (!ok)
         return ERROR_CODE_COMMON;
 
-    if (this->m_pGlobalData->m_UserList.itemExists(name)) {
-        if (!this->m_pGlobalData->m_UserList.userChangeProperties(name, prop)) {
-            qWarning() << QString("Error changing property from user %1 to 0x%2").arg(name, QString::number(prop, 16));
-            return ERROR_CODE_COMMON;
-        }
-    } else {
-        if (this->m_pGlobalData->m_UserList.addNewUser(name, name, prop) <= 0) {
-            qInfo() << QString("Error adding user %1").arg(name);
-            return ERROR_CODE_COMMON;
-        }
-        this->m_pGlobalData->m_UserList.userChangeProperties(name, prop);
-    }
+    update.m_index    = 0;
+    update.m_bChanged = false;
+
+    this->m_lUsers.append(update);
     return ERROR_CODE_SUCCESS;
 }
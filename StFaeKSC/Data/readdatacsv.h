@@ -20,6 +20,8 @@
 #define READDATACSV_H
 
 
+#include <QtCore/QByteArray>
+#include <QtCore/QList>
 #include <QtCore/QString>
 
 #include "../General/globaldata.h"
@@ -36,8 +38,12 @@ private:
     GlobalData  *m_pGlobalData;
 
 
-    int readNewGameData(QStringList line);
-    int readNewUserData(QStringList line);
+    QList<GameUpdate> m_lGames;
+    QList<UserUpdate> m_lUsers;
+
+    int parseCSVData(const QByteArray& data);
+    int readNewGameData(const QList<QByteArray>& line);
+    int readNewUserData(const QList<QByteArray>& line);
 };
 
 #endif // READDATACSV_H
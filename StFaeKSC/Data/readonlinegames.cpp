@@ -18,18 +18,66 @@
 
 #include <QtCore/QDateTime>
 #include <QtCore/QDebug>
+#include <QtCore/QElapsedTimer>
 #include <QtCore/QFile>
 #include <QtCore/QJsonDocument>
 #include <QtCore/QJsonValue>
+#include <QtCore/QSettings>
+
+#include <algorithm>
 
 #include "../Common/General/globalfunctions.h"
 #include "readonlinegames.h"
 
-#define GETMATCH_DATA "https://www.openligadb.de/api/getmatchdata"
+#define ONLINE_DEFAULT_SOURCE "https://www.openligadb.de/api"
+#define GETMATCH_DATA "getmatchdata"
+#define GETLASTCHANGE_DATE "getlastchangedate"
 
 #define MINUTE_IN_MSEC 60 * qint64(1000)
 #define HOUR_IN_MSEC 60 * 60 * qint64(1000)
 
+#define MAX_PARALLEL_REQUESTS 4
+#define REQUEST_TIMEOUT_MSEC 5000
+
+#define LIVE_WINDOW_MSEC (8 * HOUR_IN_MSEC)
+#define LIVE_UPDATE_MSEC (5 * MINUTE_IN_MSEC)
+#define FINISHED_GRACE_MSEC (30 * MINUTE_IN_MSEC)
+#undef DEBUG_UPDATE
+//#define DEBUG_UPDATE
+#ifdef DEBUG_UPDATE
+#define DEFAULT_UPDATE_MSEC (2 * MINUTE_IN_MSEC)
+#else
+#define DEFAULT_UPDATE_MSEC (6 * HOUR_IN_MSEC)
+#endif
+#define FILL_UPDATE_MSEC (15 * MINUTE_IN_MSEC)
+
+// clang-format off
+#define ONLINE_GROUP_COMPETITION    "Competition"
+#define ONLINE_GROUP_TEAM           "Team"
+#define ONLINE_CONFIG_ARRAY         "item"
+#define ONLINE_COMP_NAME            "name"
+#define ONLINE_COMP_SEASON          "season"
+#define ONLINE_COMP_MAX_INDEX       "maxIndex"
+#define ONLINE_TEAM_NAME            "name"
+#define ONLINE_TEAM_SHORT_NAME      "shortName"
+
+#define ONLINE_GROUP_SOURCE         "Source"
+#define ONLINE_SOURCE_URL           "url"
+
+#define ONLINE_GROUP_STATE          "State"
+#define ONLINE_STATE_COMP           "competition"
+#define ONLINE_STATE_SEASON         "season"
+#define ONLINE_STATE_INDEX          "index"
+#define ONLINE_STATE_MATCH_ID       "matchID"
+#define ONLINE_STATE_TEAM1          "team1"
+#define ONLINE_STATE_TEAM2          "team2"
+#define ONLINE_STATE_SCORE          "score"
+#define ONLINE_STATE_TIMESTAMP      "timeStamp"
+#define ONLINE_STATE_LAST_UPDATE    "lastUpdate"
+#define ONLINE_STATE_MATCHDAY       "matchDayChange"
+#define ONLINE_STATE_FINISHED       "finished"
+// clang-format on
+
 
 ReadOnlineGames::ReadOnlineGames(QObject* parent)
     : BackgroundWorker(parent)
@@ -38,42 +86,40 @@ ReadOnlineGames::ReadOnlineGames(QObject* parent)
 
 void ReadOnlineGames::initialize(GlobalData* globalData)
 {
-    this->m_globalData          = globalData;
-    this->m_currentRequestIndex = -1;
+    this->m_globalData      = globalData;
+    this->m_netAccess       = NULL;
+    this->m_bAllGamesListed = false;
+    this->m_bStateChanged   = false;
+    this->m_currentGameInfo = NULL;
 }
 
 
 int ReadOnlineGames::DoBackgroundWork()
 {
-    this->m_currentRequestIndex = -1;
-
-    RequestList* list1 = new RequestList();
-    list1->m_comp      = "bl3";
-    list1->m_maxIndex  = 38;
-    list1->m_season    = 2017;
-    this->m_requestList.append(list1);
+    this->m_bAllGamesListed = false;
 
-    RequestList* list2 = new RequestList();
-    list2->m_comp      = "dfb2017";
-    list2->m_maxIndex  = 1;
-    list2->m_season    = 2017;
-    this->m_requestList.append(list2);
+    this->readOnlineGamesConfig();
+    this->readOnlineGamesState();
 
-    this->m_netAccess = new QNetworkAccessManager();
+    if (this->m_netAccess == NULL)
+        this->m_netAccess = new QNetworkAccessManager();
     connect(this->m_netAccess, &QNetworkAccessManager::finished, this, &ReadOnlineGames::slotNetWorkRequestFinished);
 
     this->m_networkTimout = new QTimer();
     this->m_networkTimout->setSingleShot(true);
-    this->m_networkTimout->setInterval(5000);
     connect(this->m_networkTimout, &QTimer::timeout, this, &ReadOnlineGames::slotNetWorkRequestTimeout);
 
     this->m_networkUpdate = new QTimer();
     this->m_networkUpdate->setSingleShot(true);
+    this->m_networkUpdate->setTimerType(Qt::PreciseTimer);
     connect(this->m_networkUpdate, &QTimer::timeout, this, &ReadOnlineGames::slotNetWorkUpdateTimeout);
 
 #ifdef QT_DEBUG
-    qInfo().noquote() << "Did not use ReadOnlineGame because of debugging";
-    return 0;
+    /* a replay source (file:// or local server) can also be used when debugging */
+    if (this->m_sourceUrl == ONLINE_DEFAULT_SOURCE) {
+        qInfo().noquote() << "Did not use ReadOnlineGame because of debugging";
+        return 0;
+    }
 #endif
 
     this->checkNewNetworkRequest(false);
@@ -81,6 +127,188 @@ int ReadOnlineGames::DoBackgroundWork()
     return 0;
 }
 
+/*
+ * Competitions and tracked teams are read from OnlineGames.ini, when it is empty it is
+ * filled with the former fixed values
+ */
+void ReadOnlineGames::readOnlineGamesConfig()
+{
+    this->m_sourceUrl = ONLINE_DEFAULT_SOURCE;
+
+    QString configFilePath = getUserHomeConfigPath() + "/Settings/OnlineGames.ini";
+    if (!checkFilePathExistAndCreate(configFilePath)) {
+        qCritical().noquote() << QString("Could not create File for online games setting");
+        return;
+    }
+
+    QSettings settings(configFilePath, QSettings::IniFormat);
+    settings.setIniCodec(("UTF-8"));
+
+    settings.beginGroup(ONLINE_GROUP_SOURCE);
+    this->m_sourceUrl = settings.value(ONLINE_SOURCE_URL, ONLINE_DEFAULT_SOURCE).toString();
+    if (this->m_sourceUrl.endsWith("/"))
+        this->m_sourceUrl.chop(1);
+    settings.endGroup();
+    if (this->m_sourceUrl != ONLINE_DEFAULT_SOURCE)
+        qInfo().noquote() << QString("Reading online games from %1").arg(this->m_sourceUrl);
+
+    int sizeOfComp = settings.beginReadArray(ONLINE_GROUP_COMPETITION);
+    for (int i = 0; i < sizeOfComp; i++) {
+        settings.setArrayIndex(i);
+        RequestList* list = new RequestList();
+        list->m_comp      = settings.value(ONLINE_COMP_NAME, "").toString();
+        list->m_season    = settings.value(ONLINE_COMP_SEASON, 0).toUInt();
+        list->m_maxIndex  = settings.value(ONLINE_COMP_MAX_INDEX, 0).toUInt();
+        if (list->m_comp.isEmpty() || list->m_season == 0 || list->m_maxIndex == 0) {
+            qWarning().noquote() << QString("Ignoring wrong online competition %1").arg(i);
+            delete list;
+            continue;
+        }
+        this->m_requestList.append(list);
+    }
+    settings.endArray();
+
+    int sizeOfTeam = settings.beginReadArray(ONLINE_GROUP_TEAM);
+    for (int i = 0; i < sizeOfTeam; i++) {
+        settings.setArrayIndex(i);
+        TrackedTeam team;
+        team.m_name       = settings.value(ONLINE_TEAM_NAME, "").toString();
+        team.m_lJsonNames = getJsonNames(team.m_name);
+        team.m_shortName  = settings.value(ONLINE_TEAM_SHORT_NAME, team.m_name).toString();
+        if (!team.m_name.isEmpty())
+            this->m_trackedTeams.append(team);
+    }
+    settings.endArray();
+
+    if (this->m_requestList.size() == 0) {
+        RequestList* list1 = new RequestList();
+        list1->m_comp      = "bl3";
+        list1->m_maxIndex  = 38;
+        list1->m_season    = 2017;
+        this->m_requestList.append(list1);
+
+        RequestList* list2 = new RequestList();
+        list2->m_comp      = "dfb2017";
+        list2->m_maxIndex  = 1;
+        list2->m_season    = 2017;
+        this->m_requestList.append(list2);
+
+        settings.beginWriteArray(ONLINE_GROUP_COMPETITION);
+        for (int i = 0; i < this->m_requestList.size(); i++) {
+            settings.setArrayIndex(i);
+            settings.setValue(ONLINE_COMP_NAME, this->m_requestList[i]->m_comp);
+            settings.setValue(ONLINE_COMP_SEASON, this->m_requestList[i]->m_season);
+            settings.setValue(ONLINE_COMP_MAX_INDEX, this->m_requestList[i]->m_maxIndex);
+        }
+        settings.endArray();
+    }
+
+    if (this->m_trackedTeams.size() == 0) {
+        TrackedTeam team;
+        team.m_name       = "Karlsruher SC";
+        team.m_lJsonNames = getJsonNames(team.m_name);
+        team.m_shortName  = "KSC";
+        this->m_trackedTeams.append(team);
+
+        settings.beginWriteArray(ONLINE_GROUP_TEAM);
+        settings.setArrayIndex(0);
+        settings.setValue(ONLINE_TEAM_NAME, team.m_name);
+        settings.setValue(ONLINE_TEAM_SHORT_NAME, team.m_shortName);
+        settings.endArray();
+    }
+
+    qInfo().noquote() << QString("Reading %1 online competitions for %2 teams")
+                             .arg(this->m_requestList.size())
+                             .arg(this->m_trackedTeams.size());
+}
+
+/*
+ * The games read online are stored in OnlineGamesState.ini, so after a restart only the
+ * changes have to be polled and the matchdays are not crawled again
+ */
+void ReadOnlineGames::readOnlineGamesState()
+{
+    QString stateFilePath = getUserHomeConfigPath() + "/Settings/OnlineGamesState.ini";
+    if (!checkFilePathExistAndCreate(stateFilePath))
+        return;
+
+    QSettings settings(stateFilePath, QSettings::IniFormat);
+    settings.setIniCodec(("UTF-8"));
+
+    int sizeOfGames = settings.beginReadArray(ONLINE_GROUP_STATE);
+    for (int i = 0; i < sizeOfGames; i++) {
+        settings.setArrayIndex(i);
+        OnlineGameInfo* info = new OnlineGameInfo();
+        info->m_competition  = settings.value(ONLINE_STATE_COMP, "").toString();
+        info->m_season       = settings.value(ONLINE_STATE_SEASON, 0).toUInt();
+        info->m_index        = settings.value(ONLINE_STATE_INDEX, 0).toUInt();
+        info->m_matchID      = settings.value(ONLINE_STATE_MATCH_ID, 0).toUInt();
+        info->m_team1        = settings.value(ONLINE_STATE_TEAM1, "").toString();
+        info->m_team2        = settings.value(ONLINE_STATE_TEAM2, "").toString();
+        info->m_score        = settings.value(ONLINE_STATE_SCORE, "").toString();
+        info->m_timeStamp    = settings.value(ONLINE_STATE_TIMESTAMP, 0).toLongLong();
+        info->m_lastUpdate     = settings.value(ONLINE_STATE_LAST_UPDATE, 0).toLongLong();
+        info->m_matchDayChange = settings.value(ONLINE_STATE_MATCHDAY, 0).toLongLong();
+        info->m_gameFinished   = settings.value(ONLINE_STATE_FINISHED, false).toBool();
+
+        /* only take games of the configured competitions */
+        bool bConfigured = false;
+        foreach (RequestList* request, this->m_requestList) {
+            if (request->m_comp == info->m_competition && request->m_season == info->m_season
+                && info->m_index >= 1 && info->m_index <= request->m_maxIndex)
+                bConfigured = true;
+        }
+        if (!bConfigured || info->m_matchID == 0 || this->existCurrentGameInfo(info) != NULL) {
+            delete info;
+            continue;
+        }
+
+        this->m_onlineGames.append(info);
+        this->m_onlineGamesIndex.insert(this->getGameKey(info), info);
+        this->scheduleGame(info);
+    }
+    settings.endArray();
+
+    if (this->m_onlineGames.size() >= this->getTotalCountOfRequest()) {
+        this->m_bAllGamesListed = true;
+        qInfo().noquote() << QString("Got all %1 games from stored online state").arg(this->m_onlineGames.size());
+    } else
+        qInfo().noquote() << QString("Got %1 games from stored online state").arg(this->m_onlineGames.size());
+}
+
+bool ReadOnlineGames::saveOnlineGamesState()
+{
+    if (!this->m_bStateChanged)
+        return false;
+
+    QString   stateFilePath = getUserHomeConfigPath() + "/Settings/OnlineGamesState.ini";
+    QSettings settings(stateFilePath, QSettings::IniFormat);
+    settings.setIniCodec(("UTF-8"));
+
+    settings.remove(ONLINE_GROUP_STATE);
+    settings.beginWriteArray(ONLINE_GROUP_STATE);
+    for (int i = 0; i < this->m_onlineGames.size(); i++) {
+        OnlineGameInfo* info = this->m_onlineGames[i];
+        settings.setArrayIndex(i);
+        settings.setValue(ONLINE_STATE_COMP, info->m_competition);
+        settings.setValue(ONLINE_STATE_SEASON, info->m_season);
+        settings.setValue(ONLINE_STATE_INDEX, info->m_index);
+        settings.setValue(ONLINE_STATE_MATCH_ID, info->m_matchID);
+        settings.setValue(ONLINE_STATE_TEAM1, info->m_team1);
+        settings.setValue(ONLINE_STATE_TEAM2, info->m_team2);
+        settings.setValue(ONLINE_STATE_SCORE, info->m_score);
+        settings.setValue(ONLINE_STATE_TIMESTAMP, info->m_timeStamp);
+        settings.setValue(ONLINE_STATE_LAST_UPDATE, info->m_lastUpdate);
+        settings.setValue(ONLINE_STATE_MATCHDAY, info->m_matchDayChange);
+        settings.setValue(ONLINE_STATE_FINISHED, info->m_gameFinished);
+    }
+    settings.endArray();
+    settings.sync();
+
+    this->m_bStateChanged = false;
+    return true;
+}
+
 qint32 ReadOnlineGames::getTotalCountOfRequest()
 {
     qint32 rValue = 0;
@@ -129,98 +357,129 @@ OnlineGameInfo* ReadOnlineGames::getNextRequest(OnlineGameInfo* currentGame)
 void ReadOnlineGames::startNetWorkRequest(OnlineGameInfo* info)
 {
 
-    OnlineGameInfo* duplex = this->existCurrentGameInfo(info);
+    OnlineGameInfo* duplex      = this->existCurrentGameInfo(info);
+    bool            bLastChange = false;
     QString         request;
     if (duplex != NULL) {
-        this->m_currentGameInfo = duplex;
-        if (!this->m_onlineGames.contains(info))
+        if (!this->isOnlineGame(info))
             delete info;
-
-        request = QString("%1/%2").arg(GETMATCH_DATA).arg(duplex->m_matchID);
+        info = duplex;
+
+        /* Known games only ask for the last change of their matchday, the game is loaded when it changed */
+        if (info->m_lastUpdate > 0) {
+            request     = QString("%1/%2/%3/%4/%5").arg(this->m_sourceUrl, GETLASTCHANGE_DATE, info->m_competition).arg(info->m_season).arg(info->m_index);
+            bLastChange = true;
+        } else
+            request = QString("%1/%2/%3").arg(this->m_sourceUrl, GETMATCH_DATA).arg(info->m_matchID);
     } else {
-        this->m_currentGameInfo = info;
-        request                 = QString("%1/%2/%3/%4").arg(GETMATCH_DATA, info->m_competition).arg(info->m_season).arg(info->m_index);
+        request = QString("%1/%2/%3/%4/%5").arg(this->m_sourceUrl, GETMATCH_DATA, info->m_competition).arg(info->m_season).arg(info->m_index);
     }
 
-    this->m_bRequestCanceled = false;
+    this->m_lastRequest.m_competition = info->m_competition;
+    this->m_lastRequest.m_season      = info->m_season;
+    this->m_lastRequest.m_index       = info->m_index;
 
-    qInfo().noquote() << QString("Request for game %1").arg(this->m_currentGameInfo->m_index);
+    qInfo().noquote() << QString("Request for game %1").arg(info->m_index);
 
-#ifdef QT_DEBUG
-    qInfo().noquote() << QString("Single game answer for game %1:%2")
-                             .arg(this->m_currentGameInfo->m_index)
-                             .arg(this->m_currentGameInfo->m_competition);
-    this->checkNewNetworkRequest(true);
-#else
 #if (QT_VERSION < QT_VERSION_CHECK(5, 8, 0))
     qInfo().noquote() << "Did not use ReadOnlineGame because of version problem";
+    if (!this->isOnlineGame(info))
+        delete info;
 #else
-    this->m_networkTimout->start();
-    this->m_netAccess->get(QNetworkRequest(QUrl(request)));
-#endif
+    this->sendNetWorkRequest(info, request, bLastChange);
 #endif
 }
 
-OnlineGameInfo* ReadOnlineGames::existCurrentGameInfo(OnlineGameInfo* info)
+void ReadOnlineGames::sendNetWorkRequest(OnlineGameInfo* info, const QString& url, bool bLastChange)
 {
-    for (int i = 0; i < this->m_onlineGames.size(); i++) {
-        if (this->m_onlineGames[i]->m_competition == info->m_competition) {
-            if (this->m_onlineGames[i]->m_season == info->m_season) {
-                if (this->m_onlineGames[i]->m_index == info->m_index)
-                    return this->m_onlineGames[i];
-            }
-        }
+    QNetworkRequest netRequest((QUrl(url)));
+    if (this->m_httpCache.contains(url)) {
+        const HttpCacheInfo& cache = this->m_httpCache[url];
+        if (!cache.m_eTag.isEmpty())
+            netRequest.setRawHeader("If-None-Match", cache.m_eTag);
+        if (!cache.m_lastModified.isEmpty())
+            netRequest.setRawHeader("If-Modified-Since", cache.m_lastModified);
     }
-    return NULL;
+
+    OnlineRequest* pRequest = new OnlineRequest();
+    pRequest->m_info        = info;
+    pRequest->m_url         = url;
+    pRequest->m_timeout     = QDateTime::currentMSecsSinceEpoch() + REQUEST_TIMEOUT_MSEC;
+    pRequest->m_bFinished   = false;
+    pRequest->m_bLastChange = bLastChange;
+    pRequest->m_reply       = this->m_netAccess->get(netRequest);
+    this->m_lPendingRequests.append(pRequest);
+    this->m_roundStats.m_requests++;
 }
 
-void ReadOnlineGames::checkNewNetworkRequest(bool checkLastItem)
+OnlineGameInfo* ReadOnlineGames::existCurrentGameInfo(OnlineGameInfo* info)
 {
-    bool   fastUpdate;
-    qint64 nextUpdate;
+    return this->m_onlineGamesIndex.value(this->getGameKey(info), NULL);
+}
 
-    if (this->m_currentRequestIndex < 0) {
-        /* catch as long there are not all games listed */
-        if (this->m_onlineGames.size() < this->getTotalCountOfRequest()) {
-            OnlineGameInfo* gameInfo = NULL;
-            if (checkLastItem)
-                gameInfo = this->getNextRequest(this->m_currentGameInfo);
-            else
-                gameInfo = this->getNextRequest(NULL);
-
-            if (gameInfo != NULL) {
-                gameInfo->m_matchID = 0;
-
-                this->startNetWorkRequest(gameInfo);
-                return;
-            }
-        } else {
-            this->m_currentRequestIndex = 0;
-            qInfo().noquote() << "Got all games for internal list";
-        }
-        nextUpdate = this->getNextGameInMilliSeconds(fastUpdate);
-    } else {
-        nextUpdate          = this->getNextGameInMilliSeconds(fastUpdate);
-        qint64 oneMonthsAgo = QDateTime::currentDateTime().addMonths(-1).toMSecsSinceEpoch();
-        while (this->m_currentRequestIndex < this->m_onlineGames.size()) {
-            OnlineGameInfo* gameInfo = this->m_onlineGames[this->m_currentRequestIndex];
-            this->m_currentRequestIndex++;
-            /* if game was 1 month ago, forget it */
-            if (gameInfo->m_gameFinished && gameInfo->m_timeStamp < oneMonthsAgo)
-                continue;
+bool ReadOnlineGames::isOnlineGame(OnlineGameInfo* info)
+{
+    return this->existCurrentGameInfo(info) == info;
+}
 
-            /* Filter games which are not listed in this fast period */
-            if (fastUpdate) {
-                qint64 diffTime = nextUpdate - gameInfo->m_timeStamp;
-                if (diffTime > 8 * HOUR_IN_MSEC || diffTime < 0)
-                    continue;
-            }
-            this->startNetWorkRequest(gameInfo);
-            return;
+QString ReadOnlineGames::getGameKey(OnlineGameInfo* info)
+{
+    return QString("%1:%2:%3").arg(info->m_competition).arg(info->m_season).arg(info->m_index);
+}
+
+/*
+ * Keeps up to MAX_PARALLEL_REQUESTS requests running. When all requests of this round are
+ * answered, the next round is planned.
+ */
+void ReadOnlineGames::checkNewNetworkRequest(bool checkLastItem)
+{
+    while (this->m_lPendingRequests.size() < MAX_PARALLEL_REQUESTS) {
+        if (this->m_lMatchDataRequests.size() > 0) {
+            OnlineGameInfo* info = this->m_lMatchDataRequests.takeFirst();
+            this->sendNetWorkRequest(info, QString("%1/%2/%3").arg(this->m_sourceUrl, GETMATCH_DATA).arg(info->m_matchID), false);
+            continue;
         }
-        this->m_currentRequestIndex = 0;
+
+        OnlineGameInfo* gameInfo = this->getNextGameInfo(checkLastItem);
+        if (gameInfo == NULL)
+            break;
+        if (this->m_roundStats.m_startTime == 0)
+            this->m_roundStats.m_startTime = QDateTime::currentMSecsSinceEpoch();
+        this->startNetWorkRequest(gameInfo);
+        checkLastItem = true;
     }
 
+    if (this->m_lPendingRequests.size() > 0) {
+        this->startNextRequestTimeout();
+        return;
+    }
+
+    int nChangedGames = this->applyGameUpdates();
+    if (nChangedGames > 0)
+        this->m_roundStats.m_writes++;
+    if (this->saveOnlineGamesState())
+        this->m_roundStats.m_writes++;
+
+    if (this->m_roundStats.m_startTime > 0) {
+        this->m_roundStats.m_changedGames = nChangedGames;
+        this->m_roundStats.m_duration     = QDateTime::currentMSecsSinceEpoch() - this->m_roundStats.m_startTime;
+        qInfo().noquote() << QString("Online round: %1 requests, %2 bytes, %3 games changed, %4 writes in %5ms")
+                                 .arg(this->m_roundStats.m_requests)
+                                 .arg(this->m_roundStats.m_bytes)
+                                 .arg(this->m_roundStats.m_changedGames)
+                                 .arg(this->m_roundStats.m_writes)
+                                 .arg(this->m_roundStats.m_duration);
+        this->m_lastRoundStats = this->m_roundStats;
+        this->m_roundStats     = OnlineRoundStats();
+        emit this->signalOnlineRoundFinished();
+    }
+
+    if (!this->m_bAllGamesListed && this->m_onlineGames.size() >= this->getTotalCountOfRequest()) {
+        this->m_bAllGamesListed = true;
+        qInfo().noquote() << "Got all games for internal list";
+    }
+    qint64 nextUpdate = this->getNextEventTime();
+
     qint64 now = QDateTime::currentMSecsSinceEpoch();
     if (nextUpdate > now) {
         qInfo().noquote() << QString("Sleeping and reading again in %1 seconds").arg((nextUpdate - now) / 1000);
@@ -229,44 +488,107 @@ void ReadOnlineGames::checkNewNetworkRequest(bool checkLastItem)
         this->slotNetWorkUpdateTimeout();
 }
 
-qint64 ReadOnlineGames::getNextGameInMilliSeconds(bool& fastUpdate)
+int ReadOnlineGames::applyGameUpdates()
 {
-    qint64 now = QDateTime::currentDateTime().toMSecsSinceEpoch();
+    if (this->m_lGameUpdates.size() == 0)
+        return 0;
 
-    /* if list is not full, update every 15 min */
-    if (this->m_currentRequestIndex < 0)
-        return now + (15 * MINUTE_IN_MSEC);
+    int nChanged = this->m_globalData->m_GamesList.updateGames(this->m_lGameUpdates);
 
-#undef DEBUG_UPDATE
-//#define DEBUG_UPDATE
-#ifdef DEBUG_UPDATE
-    qint64 rValue = now + (2 * MINUTE_IN_MSEC);
-#else
-    qint64 rValue = now + (6 * HOUR_IN_MSEC); // 6h - 1000ms * 60s * 60min * 4
-#endif
+    foreach (const GameUpdate& update, this->m_lGameUpdates) {
+        if (update.m_bChanged && update.m_index > 0)
+            this->m_globalData->sendPushChange(PUSH_GAME_CHANGED, update.m_index);
+    }
+    this->m_lGameUpdates.clear();
 
-    fastUpdate = false;
+    return nChanged;
+}
 
-    for (int i = 0; i < this->m_onlineGames.size(); i++) {
-        qint64 timestamp = this->m_onlineGames[i]->m_timeStamp;
-        /* game was in past */
-        if (now > timestamp) {
-            if (this->m_onlineGames[i]->m_gameFinished)
-                continue;
+/* Returns the next game which should be requested in this round, NULL when there is none */
+OnlineGameInfo* ReadOnlineGames::getNextGameInfo(bool checkLastItem)
+{
+    if (!this->m_bAllGamesListed) {
+        /* catch as long there are not all games listed */
+        if (this->m_onlineGames.size() >= this->getTotalCountOfRequest())
+            return NULL;
+
+        OnlineGameInfo* gameInfo = NULL;
+        if (checkLastItem)
+            gameInfo = this->getNextRequest(&this->m_lastRequest);
+        else
+            gameInfo = this->getNextRequest(NULL);
+
+        if (gameInfo != NULL)
+            gameInfo->m_matchID = 0;
+        return gameInfo;
+    }
 
-            if ((now - timestamp) < (8 * HOUR_IN_MSEC)) {
-                rValue     = now + (5 * MINUTE_IN_MSEC);
-                fastUpdate = true;
-                return rValue;
-            }
+    /* all games listed, take the games which are due from the event heap */
+    qint64 now = QDateTime::currentMSecsSinceEpoch();
+    while (this->m_eventHeap.size() > 0 && this->m_eventHeap.first().m_time <= now) {
+        OnlineGameEvent event = this->m_eventHeap.first();
+        std::pop_heap(this->m_eventHeap.begin(), this->m_eventHeap.end(), OnlineGameEvent::laterEventFunction);
+        this->m_eventHeap.removeLast();
+
+        /* game was scheduled again in between, this entry is old */
+        if (event.m_info->m_nextEvent != event.m_time)
             continue;
+        event.m_info->m_nextEvent = 0;
+        return event.m_info;
+    }
+    return NULL;
+}
+
+/*
+ * Puts the game into the event heap with the next time it is relevant: the kick-off, every
+ * 5 min while it is running, every 30 min in the grace period after the final whistle and
+ * otherwise every 6 hours to see moved games. Finished games older than one month are not
+ * read again.
+ */
+void ReadOnlineGames::scheduleGame(OnlineGameInfo* info)
+{
+    qint64 now      = QDateTime::currentMSecsSinceEpoch();
+    qint64 kickOff  = info->m_timeStamp;
+    qint64 nextTime = now + DEFAULT_UPDATE_MSEC;
+
+    if (info->m_gameFinished) {
+        if (kickOff < QDateTime::currentDateTime().addMonths(-1).toMSecsSinceEpoch()) {
+            info->m_nextEvent = 0;
+            return;
         }
+        if (now - kickOff < LIVE_WINDOW_MSEC)
+            nextTime = now + FINISHED_GRACE_MSEC;
+    } else if (now < kickOff) {
+        if (kickOff + 10 < nextTime)
+            nextTime = kickOff + 10;
+    } else if (now - kickOff < LIVE_WINDOW_MSEC)
+        nextTime = now + LIVE_UPDATE_MSEC;
+
+    OnlineGameEvent event;
+    event.m_time      = nextTime;
+    event.m_info      = info;
+    info->m_nextEvent = nextTime;
+    this->m_eventHeap.append(event);
+    std::push_heap(this->m_eventHeap.begin(), this->m_eventHeap.end(), OnlineGameEvent::laterEventFunction);
+}
+
+qint64 ReadOnlineGames::getNextEventTime()
+{
+    qint64 now = QDateTime::currentMSecsSinceEpoch();
 
-        /* If game is less than 6 hours in future, take start of game (plus 10msec) */
-        if ((timestamp - now) < (6 * HOUR_IN_MSEC))
-            rValue = timestamp + 10;
+    /* if list is not full, update every 15 min */
+    if (!this->m_bAllGamesListed)
+        return now + FILL_UPDATE_MSEC;
+
+    /* remove old entries of games which were scheduled again */
+    while (this->m_eventHeap.size() > 0 && this->m_eventHeap.first().m_info->m_nextEvent != this->m_eventHeap.first().m_time) {
+        std::pop_heap(this->m_eventHeap.begin(), this->m_eventHeap.end(), OnlineGameEvent::laterEventFunction);
+        this->m_eventHeap.removeLast();
     }
-    return rValue;
+
+    if (this->m_eventHeap.size() == 0)
+        return now + DEFAULT_UPDATE_MSEC;
+    return this->m_eventHeap.first().m_time;
 }
 
 void ReadOnlineGames::slotNetWorkUpdateTimeout()
@@ -276,41 +598,229 @@ void ReadOnlineGames::slotNetWorkUpdateTimeout()
     this->checkNewNetworkRequest(false);
 }
 
+void ReadOnlineGames::startNextRequestTimeout()
+{
+    qint64 nextTimeout = 0;
+    foreach (OnlineRequest* pRequest, this->m_lPendingRequests) {
+        if (pRequest->m_bFinished)
+            continue;
+        if (nextTimeout == 0 || pRequest->m_timeout < nextTimeout)
+            nextTimeout = pRequest->m_timeout;
+    }
+
+    if (nextTimeout == 0) {
+        this->m_networkTimout->stop();
+        return;
+    }
+    qint64 diff = nextTimeout - QDateTime::currentMSecsSinceEpoch();
+    this->m_networkTimout->start(diff > 0 ? int(diff) : 0);
+}
+
 void ReadOnlineGames::slotNetWorkRequestTimeout()
 {
-    this->m_bRequestCanceled = true;
+    qint64 now = QDateTime::currentMSecsSinceEpoch();
+    foreach (OnlineRequest* pRequest, this->m_lPendingRequests) {
+        if (pRequest->m_bFinished || pRequest->m_timeout > now)
+            continue;
+
+        qInfo().noquote() << QString("Timeout of request for game %1:%2")
+                                 .arg(pRequest->m_info->m_index)
+                                 .arg(pRequest->m_info->m_competition);
+        /* abort emits finished, the request is already marked so the answer is ignored. The
+         * matchday is asked for again next round, the game was maybe not read after a change. */
+        pRequest->m_bFinished              = true;
+        pRequest->m_info->m_matchDayChange = 0;
+        pRequest->m_reply->abort();
+    }
+
+    this->applyFinishedRequests();
     this->checkNewNetworkRequest(true);
 }
 
 void ReadOnlineGames::slotNetWorkRequestFinished(QNetworkReply* reply)
 {
-    if (this->m_bRequestCanceled)
+    OnlineRequest* pRequest = NULL;
+    foreach (OnlineRequest* pending, this->m_lPendingRequests) {
+        if (pending->m_reply == reply) {
+            pRequest = pending;
+            break;
+        }
+    }
+    if (pRequest == NULL) {
+        reply->deleteLater();
         return;
+    }
+    if (pRequest->m_bFinished)
+        return;
+
+    int status = reply->attribute(QNetworkRequest::HttpStatusCodeAttribute).toInt();
+    if (status == 304) {
+        qInfo().noquote() << QString("Not modified for game %1:%2")
+                                 .arg(pRequest->m_info->m_index)
+                                 .arg(pRequest->m_info->m_competition);
+    } else if (reply->error() != QNetworkReply::NoError) {
+        qInfo().noquote() << QString("Error %1 of request for game %2:%3")
+                                 .arg(reply->error())
+                                 .arg(pRequest->m_info->m_index)
+                                 .arg(pRequest->m_info->m_competition);
+        pRequest->m_info->m_matchDayChange = 0;
+    } else {
+        pRequest->m_answer = reply->readAll();
+        this->m_roundStats.m_bytes += pRequest->m_answer.size();
+        if (status == 200) {
+            HttpCacheInfo cache;
+            cache.m_eTag         = reply->rawHeader("ETag");
+            cache.m_lastModified = reply->rawHeader("Last-Modified");
+            if (!cache.m_eTag.isEmpty() || !cache.m_lastModified.isEmpty())
+                this->m_httpCache.insert(pRequest->m_url, cache);
+        }
+    }
+    pRequest->m_bFinished = true;
+
+    this->applyFinishedRequests();
+    this->checkNewNetworkRequest(true);
+}
+
+/*
+ * Answers are applied to the games list in the order of their requests, so the list changes
+ * the same way as when requesting one game after the other
+ */
+void ReadOnlineGames::applyFinishedRequests()
+{
+    while (this->m_lPendingRequests.size() > 0 && this->m_lPendingRequests.first()->m_bFinished) {
+        OnlineRequest* pRequest = this->m_lPendingRequests.takeFirst();
+
+        this->m_currentGameInfo = pRequest->m_info;
+        bool bSendAgain         = false;
+        if (pRequest->m_bLastChange) {
+            bSendAgain = this->hasMatchDayChanged(pRequest->m_answer, pRequest->m_info);
+            /* started from checkNewNetworkRequest, so it counts for MAX_PARALLEL_REQUESTS */
+            if (bSendAgain)
+                this->m_lMatchDataRequests.append(pRequest->m_info);
+        } else if (!pRequest->m_answer.isEmpty())
+            this->readRequestAnswer(pRequest->m_answer);
+
+        if (!this->isOnlineGame(pRequest->m_info))
+            delete pRequest->m_info;
+        else if (!bSendAgain)
+            this->scheduleGame(pRequest->m_info);
+        this->m_currentGameInfo = NULL;
+
+        pRequest->m_reply->deleteLater();
+        delete pRequest;
+    }
+}
+
+/*
+ * The answer of getlastchangedate is a json string like "2017-08-05T15:23:11.447". It is the
+ * last change of any game of the matchday, so it is compared with the last seen change of the
+ * matchday and not with the one of the game. An empty answer (not modified or timeout) counts
+ * as not changed, the game is checked next round again.
+ */
+bool ReadOnlineGames::hasMatchDayChanged(const QByteArray& answer, OnlineGameInfo* info)
+{
+    QString lastChange = QString(answer).trimmed().remove('"');
+    if (lastChange.isEmpty())
+        return false;
+
+    qint64 lastChangeTime = this->readLastUpdateTime(lastChange);
+    if (lastChangeTime > 0 && lastChangeTime <= info->m_matchDayChange) {
+        qInfo().noquote() << QString("No change for game %1:%2").arg(info->m_index).arg(info->m_competition);
+        return false;
+    }
+
+    info->m_matchDayChange = lastChangeTime;
+    this->m_bStateChanged  = true;
+    return true;
+}
 
-    this->m_networkTimout->stop();
+qint64 ReadOnlineGames::readLastUpdateTime(QString lastUpdateDateTime)
+{
+    while (lastUpdateDateTime.size() - lastUpdateDateTime.lastIndexOf(".") < 4)
+        lastUpdateDateTime.append("0");
+    QDateTime lastUpdate = QDateTime::fromString(lastUpdateDateTime, "yyyy-MM-ddThh:mm:ss.zzz");
+    return lastUpdate.toMSecsSinceEpoch();
+}
 
-    QByteArray    arr = reply->readAll();
-    QJsonDocument d   = QJsonDocument::fromJson(arr);
+/*
+ * Finds the next object of the top level array in data starting at pos without parsing it.
+ * Strings are skipped, so braces inside of names do not count.
+ */
+bool ReadOnlineGames::findNextArrayObject(const QByteArray& data, int& pos, int& begin, int& end)
+{
+    const char* pData   = data.constData();
+    int         depth   = 0;
+    bool        bString = false;
+
+    for (; pos < data.size(); pos++) {
+        char c = pData[pos];
+        if (bString) {
+            if (c == '\\')
+                pos++;
+            else if (c == '"')
+                bString = false;
+            continue;
+        }
 
-    if (d.isArray()) { /* all Games */
+        if (c == '"')
+            bString = true;
+        else if (c == '{') {
+            if (depth == 0)
+                begin = pos;
+            depth++;
+        } else if (c == '}' && depth > 0) {
+            depth--;
+            if (depth == 0) {
+                end = ++pos;
+                return true;
+            }
+        }
+    }
+    return false;
+}
+
+/*
+ * A matchday contains all games of the competition, only the game of the tracked team is
+ * needed. The raw answer is filtered for the team name first, so only that one object is
+ * build as json.
+ */
+void ReadOnlineGames::readRequestAnswer(const QByteArray& answer)
+{
+    QElapsedTimer timer;
+    timer.start();
+
+    int teamPos = this->indexOfTrackedTeam(answer, 0);
+    if (teamPos < 0) {
+        qInfo().noquote() << QString("No tracked team in answer for game %1:%2")
+                                 .arg(this->m_currentGameInfo->m_index)
+                                 .arg(this->m_currentGameInfo->m_competition);
+        return;
+    }
+
+    if (answer.trimmed().startsWith('[')) { /* all Games */
         qInfo().noquote() << QString("Request answer for game %1:%2")
                                  .arg(this->m_currentGameInfo->m_index)
                                  .arg(this->m_currentGameInfo->m_competition);
-        QJsonArray array = d.array();
-        for (int i = 0; i < array.size(); i++) {
-            QJsonObject gameObj = array[i].toObject();
+        int pos = 0, begin = 0, end = 0;
+        while (teamPos >= 0 && findNextArrayObject(answer, pos, begin, end)) {
+            if (teamPos >= end)
+                continue;
+
+            QJsonObject gameObj = QJsonDocument::fromJson(answer.mid(begin, end - begin)).object();
             if (this->readSingleGame(gameObj))
                 break;
+            teamPos = this->indexOfTrackedTeam(answer, end);
         }
     } else { /* just single game */
-        QJsonObject gameObj = d.object();
+        QJsonDocument d       = QJsonDocument::fromJson(answer);
+        QJsonObject   gameObj = d.object();
         qInfo().noquote() << QString("Single game answer for game %1:%2")
                                  .arg(this->m_currentGameInfo->m_index)
                                  .arg(this->m_currentGameInfo->m_competition);
         this->readSingleGame(gameObj);
     }
 
-    this->checkNewNetworkRequest(true);
+    qDebug().noquote() << QString("Read answer of %1 bytes in %2us").arg(answer.size()).arg(timer.nsecsElapsed() / 1000);
 }
 
 
@@ -318,13 +828,11 @@ bool ReadOnlineGames::readSingleGame(QJsonObject& json)
 {
     if (!json.contains("LastUpdateDateTime"))
         return false;
-    QString lastUpdateDateTime = json.value("LastUpdateDateTime").toString();
-    while (lastUpdateDateTime.size() - lastUpdateDateTime.lastIndexOf(".") < 4)
-        lastUpdateDateTime.append("0");
-    QDateTime lastUpdate = QDateTime::fromString(lastUpdateDateTime, "yyyy-MM-ddThh:mm:ss.zzz");
+    qint64 lastUpdate = this->readLastUpdateTime(json.value("LastUpdateDateTime").toString());
 
-    /* if nothing changed */
-    if (this->m_currentGameInfo->m_matchID != 0 && this->m_currentGameInfo->m_lastUpdate == lastUpdate.toMSecsSinceEpoch())
+    /* if nothing changed, the team name can also be in a string of another game */
+    if (this->m_currentGameInfo->m_matchID != 0 && this->m_currentGameInfo->m_lastUpdate == lastUpdate
+        && quint32(json.value("MatchID").toInt()) == this->m_currentGameInfo->m_matchID)
         return true;
 
     /* read team 1 */
@@ -339,10 +847,12 @@ bool ReadOnlineGames::readSingleGame(QJsonObject& json)
     objTeam       = json.value("Team2").toObject();
     QString team2 = this->readSingleTeam(objTeam);
 
-    if (team1 == "Karlsruher SC")
-        team1 = "KSC";
-    else if (team2 == "Karlsruher SC")
-        team2 = "KSC";
+    QString shortName1 = this->getTrackedShortName(team1);
+    QString shortName2 = this->getTrackedShortName(team2);
+    if (!shortName1.isEmpty())
+        team1 = shortName1;
+    else if (!shortName2.isEmpty())
+        team2 = shortName2;
     else
         return false;
 
@@ -372,15 +882,18 @@ bool ReadOnlineGames::readSingleGame(QJsonObject& json)
     this->m_currentGameInfo->m_team2        = team2;
     this->m_currentGameInfo->m_score        = score;
     this->m_currentGameInfo->m_timeStamp    = gameDate.toMSecsSinceEpoch();
-    this->m_currentGameInfo->m_lastUpdate   = lastUpdate.toMSecsSinceEpoch();
+    this->m_currentGameInfo->m_lastUpdate   = lastUpdate;
     this->m_currentGameInfo->m_gameFinished = matchIsFinished;
     if (this->m_currentGameInfo->m_matchID == 0)
         this->m_currentGameInfo->m_matchID = matchID;
     else if (this->m_currentGameInfo->m_matchID != matchID)
         return false;
 
-    if (!this->m_onlineGames.contains(this->m_currentGameInfo))
+    if (!this->isOnlineGame(this->m_currentGameInfo)) {
         this->m_onlineGames.append(this->m_currentGameInfo);
+        this->m_onlineGamesIndex.insert(this->getGameKey(this->m_currentGameInfo), this->m_currentGameInfo);
+    }
+    this->m_bStateChanged = true;
 
     CompetitionIndex comp = NO_COMPETITION;
     if (this->m_currentGameInfo->m_competition == "bl1")
@@ -389,16 +902,20 @@ bool ReadOnlineGames::readSingleGame(QJsonObject& json)
         comp = BUNDESLIGA_2;
     else if (this->m_currentGameInfo->m_competition == "bl3")
         comp = LIGA_3;
-    else if (this->m_currentGameInfo->m_competition == "dfb2017")
+    else if (this->m_currentGameInfo->m_competition.startsWith("dfb"))
         comp = DFB_POKAL;
-    this->m_globalData->m_GamesList.addNewGame(this->m_currentGameInfo->m_team1,
-                                               this->m_currentGameInfo->m_team2,
-                                               this->m_currentGameInfo->m_timeStamp,
-                                               this->m_currentGameInfo->m_index,
-                                               this->m_currentGameInfo->m_score,
-                                               comp,
-                                               this->m_currentGameInfo->m_season,
-                                               this->m_currentGameInfo->m_lastUpdate);
+
+    /* the games list is changed at the end of the round, together with all other games */
+    GameUpdate update;
+    update.m_home        = this->m_currentGameInfo->m_team1;
+    update.m_away        = this->m_currentGameInfo->m_team2;
+    update.m_timestamp   = this->m_currentGameInfo->m_timeStamp;
+    update.m_saisonIndex = this->m_currentGameInfo->m_index;
+    update.m_score       = this->m_currentGameInfo->m_score;
+    update.m_competition = comp;
+    update.m_saison      = this->m_currentGameInfo->m_season;
+    update.m_lastUpdate  = this->m_currentGameInfo->m_lastUpdate;
+    this->m_lGameUpdates.append(update);
 
     return true;
     /*
@@ -406,6 +923,59 @@ bool ReadOnlineGames::readSingleGame(QJsonObject& json)
      */
 }
 
+/* Position of the first tracked team name in data from position from on, -1 if there is none */
+int ReadOnlineGames::indexOfTrackedTeam(const QByteArray& data, int from)
+{
+    int rValue = -1;
+    foreach (const TrackedTeam& team, this->m_trackedTeams) {
+        foreach (const QByteArray& jsonName, team.m_lJsonNames) {
+            int pos = data.indexOf(jsonName, from);
+            if (pos >= 0 && (rValue < 0 || pos < rValue))
+                rValue = pos;
+        }
+    }
+    return rValue;
+}
+
+/*
+ * Quotes and backslashes of the name are escaped in json, other characters than ascii can be
+ * send as utf8 or as \u00fc with lower or upper case hex digits
+ */
+QList<QByteArray> ReadOnlineGames::getJsonNames(const QString& name)
+{
+    QString escaped = name;
+    escaped.replace("\\", "\\\\").replace("\"", "\\\"");
+
+    QByteArray lower, upper;
+    foreach (const QChar& c, escaped) {
+        if (c.unicode() < 0x80) {
+            lower.append(char(c.unicode()));
+            upper.append(char(c.unicode()));
+            continue;
+        }
+        QByteArray hex = QByteArray::number(c.unicode(), 16).rightJustified(4, '0');
+        lower.append("\\u" + hex);
+        upper.append("\\u" + hex.toUpper());
+    }
+
+    QList<QByteArray> rValue;
+    rValue.append(escaped.toUtf8());
+    if (!rValue.contains(lower))
+        rValue.append(lower);
+    if (!rValue.contains(upper))
+        rValue.append(upper);
+    return rValue;
+}
+
+QString ReadOnlineGames::getTrackedShortName(const QString& name)
+{
+    foreach (const TrackedTeam& team, this->m_trackedTeams) {
+        if (team.m_name == name)
+            return team.m_shortName;
+    }
+    return "";
+}
+
 QString ReadOnlineGames::readSingleTeam(QJsonObject& json)
 {
     if (!json.contains("TeamName"))
@@ -19,11 +19,13 @@
 #ifndef READONLINEGAMES_H
 #define READONLINEGAMES_H
 
+#include <QtCore/QHash>
 #include <QtCore/QJsonArray>
 #include <QtCore/QJsonObject>
 #include <QtCore/QList>
 #include <QtCore/QObject>
 #include <QtCore/QTimer>
+#include <QtCore/QVector>
 #include <QtNetwork/QNetworkAccessManager>
 #include <QtNetwork/QNetworkReply>
 
@@ -40,12 +42,18 @@ struct OnlineGameInfo {
     quint32 m_matchID;
     qint64  m_timeStamp;
     qint64  m_lastUpdate;
+    qint64  m_matchDayChange; /* last change of the whole matchday, other games can change later */
+    qint64  m_nextEvent;      /* time of the valid entry in the event heap, 0 if none */
     bool    m_gameFinished;
 
     OnlineGameInfo()
     {
         this->m_competition = "bl";
-        this->m_season      = 2016;
+        this->m_season         = 2016;
+        this->m_matchID        = 0;
+        this->m_lastUpdate     = 0;
+        this->m_matchDayChange = 0;
+        this->m_nextEvent      = 0;
     }
 
     //    bool m_checkUpdate;
@@ -57,6 +65,60 @@ struct RequestList {
     quint32 m_maxIndex;
 };
 
+struct TrackedTeam {
+    QString           m_name;
+    QList<QByteArray> m_lJsonNames; /* the name how it can be written in a json string */
+    QString           m_shortName;
+};
+
+/* Counters of one reading round, logged when it finished */
+struct OnlineRoundStats {
+    qint64  m_startTime;
+    quint32 m_requests;
+    qint64  m_bytes;
+    quint32 m_writes;
+    quint32 m_changedGames;
+    qint64  m_duration;
+
+    OnlineRoundStats()
+    {
+        this->m_startTime    = 0;
+        this->m_requests     = 0;
+        this->m_bytes        = 0;
+        this->m_writes       = 0;
+        this->m_changedGames = 0;
+        this->m_duration     = 0;
+    }
+};
+
+/* Entry of the event heap, the game has to be read again at m_time */
+struct OnlineGameEvent {
+    qint64          m_time;
+    OnlineGameInfo* m_info;
+
+    static bool laterEventFunction(const OnlineGameEvent& e1, const OnlineGameEvent& e2)
+    {
+        return e1.m_time > e2.m_time;
+    }
+};
+
+/* One running request to openligadb, the answer is stored until all earlier requests are applied */
+struct OnlineRequest {
+    OnlineGameInfo* m_info;
+    QNetworkReply*  m_reply;
+    QString         m_url;
+    QByteArray      m_answer;
+    qint64          m_timeout;
+    bool            m_bFinished;
+    bool            m_bLastChange; /* only asks for the last change of the matchday */
+};
+
+/* Validators of the last answer for an url, send again so the server can answer "Not Modified" */
+struct HttpCacheInfo {
+    QByteArray m_eTag;
+    QByteArray m_lastModified;
+};
+
 class ReadOnlineGames : public BackgroundWorker
 {
     Q_OBJECT
@@ -66,7 +128,13 @@ public:
 
     void initialize(GlobalData* globalData);
 
+    /* has to be set before starting, e.g. to replay recorded answers, otherwise a new one is created */
+    void setNetworkAccess(QNetworkAccessManager* netAccess) { this->m_netAccess = netAccess; }
+
+    OnlineRoundStats getLastRoundStats() const { return this->m_lastRoundStats; }
+
 signals:
+    void signalOnlineRoundFinished();
 
 public slots:
     void slotNetWorkRequestFinished(QNetworkReply* reply);
@@ -80,25 +148,56 @@ protected:
     GlobalData*            m_globalData;
     QNetworkAccessManager* m_netAccess;
     QTimer*                m_networkTimout;
-    bool                   m_bRequestCanceled;
-    qint32                 m_currentRequestIndex;
-
-    QList<OnlineGameInfo*> m_onlineGames;
+    bool                   m_bAllGamesListed;
+    bool                   m_bStateChanged;
+    QString                m_sourceUrl;
+    OnlineRoundStats       m_roundStats;
+    OnlineRoundStats       m_lastRoundStats;
+
+    QList<OnlineGameInfo*>          m_onlineGames;
+    QHash<QString, OnlineGameInfo*> m_onlineGamesIndex;
+    QVector<OnlineGameEvent>        m_eventHeap;
+    QList<TrackedTeam>              m_trackedTeams;
+    QList<GameUpdate>               m_lGameUpdates;
     OnlineGameInfo*        m_currentGameInfo;
+    OnlineGameInfo         m_lastRequest;
+    QList<OnlineRequest*>  m_lPendingRequests;
+    QList<OnlineGameInfo*> m_lMatchDataRequests; /* games with a changed matchday, waiting for a free request */
+
+    QHash<QString, HttpCacheInfo> m_httpCache;
 
     QList<RequestList*> m_requestList;
+    void                readOnlineGamesConfig();
+    void                readOnlineGamesState();
+    bool                saveOnlineGamesState();
     qint32              getTotalCountOfRequest();
     OnlineGameInfo* getNextRequest(OnlineGameInfo* currentGame);
 
     QTimer* m_networkUpdate;
 
     void startNetWorkRequest(OnlineGameInfo* info);
+    void sendNetWorkRequest(OnlineGameInfo* info, const QString& url, bool bLastChange);
 
     OnlineGameInfo* existCurrentGameInfo(OnlineGameInfo* info);
+    bool isOnlineGame(OnlineGameInfo* info);
+    QString getGameKey(OnlineGameInfo* info);
 
-    qint64 getNextGameInMilliSeconds(bool& fastUpdate);
+    void   scheduleGame(OnlineGameInfo* info);
+    qint64 getNextEventTime();
 
     void checkNewNetworkRequest(bool checkLastItem);
+    OnlineGameInfo* getNextGameInfo(bool checkLastItem);
+    void startNextRequestTimeout();
+    void applyFinishedRequests();
+    int applyGameUpdates();
+    void readRequestAnswer(const QByteArray& answer);
+    bool hasMatchDayChanged(const QByteArray& answer, OnlineGameInfo* info);
+    qint64 readLastUpdateTime(QString lastUpdateDateTime);
+
+    int indexOfTrackedTeam(const QByteArray& data, int from);
+    QString getTrackedShortName(const QString& name);
+    static QList<QByteArray> getJsonNames(const QString& name);
+    static bool findNextArrayObject(const QByteArray& data, int& pos, int& begin, int& end);
 
     bool readSingleGame(QJsonObject& json);
     QString readSingleTeam(QJsonObject& json);
@@ -49,9 +49,13 @@ Console::Console(GlobalData* pData, QObject* parent)
     this->m_pGlobalData = pData;
 
     this->m_logging = new Logging();
+    this->m_logging->setBinaryFormat(QCoreApplication::arguments().contains("-binaryLog"));
     this->m_logging->initialize();
 
     this->m_ctrlLog.Start(this->m_logging, false);
+
+    this->m_topTimer.setInterval(1000);
+    connect(&this->m_topTimer, &QTimer::timeout, this, &Console::slotTopTimeout);
 }
 
 
@@ -83,6 +87,14 @@ void Console::readCommand()
 {
     std::string line;
     std::getline(std::cin, line);
+
+    /* any input ends the top view */
+    if (this->m_topTimer.isActive() && !std::cin.eof()) {
+        this->m_topTimer.stop();
+        std::cout << "> " << std::flush;
+        return;
+    }
+
     if (std::cin.eof() || line == "quit" || line == "exit") {
         std::cout << "Ending console!" << std::endl;
         emit quit();
@@ -100,6 +112,10 @@ void Console::readCommand()
             UserCommand::runReadCommand(qLine, this->m_pGlobalData);
         } else if (qLine == "log" || qLine.left(4) == "log ") {
             UserCommand::runLoggingCommand(this->m_logging, qLine);
+        } else if (qLine == "top") {
+            this->m_pGlobalData->m_statistics.getReport(); // start a new window
+            this->m_topTimer.start();
+            return;
 
         } else if (line.length() == 0) {
 
@@ -110,6 +126,13 @@ void Console::readCommand()
     }
 }
 
+void Console::slotTopTimeout()
+{
+    /* clear the terminal and start at the top */
+    std::cout << "\033[2J\033[H" << this->m_pGlobalData->m_statistics.getReport().toStdString()
+              << "\n(enter to end)" << std::flush;
+}
+
 void Console::printHelp()
 {
     std::cout << "\nConsole for StFaeKSC\n\n";
@@ -127,6 +150,14 @@ void Console::printHelp()
               << "read a new file in csv file format" << std::endl;
     std::cout << "log %i:\t\t"
               << "show the last user log" << std::endl;
+    std::cout << "log find %QUERY%:\t"
+              << "show the lines of today with user=%NAME% game=%INDEX% since=%hh:mm%" << std::endl;
+    std::cout << "log rules %RULES%:\t"
+              << "enable or disable log categories, e.g. stamorga.request.info=false" << std::endl;
+    std::cout << "log decode %PATH%:\t"
+              << "show a binary or packed log file as text" << std::endl;
+    std::cout << "top:\t\t"
+              << "show the load of the server every second, end it with enter" << std::endl;
     std::cout << "exit:\t\t"
               << "exit the program" << std::endl;
     std::cout << "quit:\t\t"
@@ -21,6 +21,7 @@
 
 #include <QObject>
 #include <QSocketNotifier>
+#include <QTimer>
 
 #include "../Common/General/backgroundcontroller.h"
 #include "../Common/General/logging.h"
@@ -40,6 +41,7 @@ signals:
 
 private slots:
     void readCommand();
+    void slotTopTimeout();
 
 private:
     QSocketNotifier* m_pSNotify;
@@ -51,6 +53,8 @@ private:
     BackgroundController m_ctrlLog;
     Logging*             m_logging;
 
+    QTimer m_topTimer;
+
 
     void printHelp();
     int  ShowUDPHelp();
@@ -18,13 +18,18 @@
 
 #include <QtCore/QDataStream>
 #include <QtCore/QDateTime>
+#include <QtCore/QLoggingCategory>
 
 #include "../Common/General/config.h"
 #include "../Common/General/globalfunctions.h"
 #include "../Common/Network/messagecommand.h"
+#include "../Common/Network/messagecompression.h"
 #include "../Data/seasonticket.h"
 #include "dataconnection.h"
 
+/* Info messages of every request, arguments are only evaluated when the category is enabled */
+Q_LOGGING_CATEGORY(logRequest, "stamorga.request")
+
 DataConnection::DataConnection(GlobalData* pGData, QObject* parent)
     : QObject(parent)
 {
@@ -57,7 +62,7 @@ MessageProtocol* DataConnection::requestCheckUserLogin(MessageProtocol* msg)
     if (rValue) {
         result                               = ERROR_CODE_SUCCESS;
         this->m_pUserConData->m_bIsConnected = true;
-        qInfo().noquote() << QString("User %1 logged in").arg(this->m_pUserConData->m_userName);
+        qCInfo(logRequest).noquote() << QString("User %1 logged in").arg(this->m_pUserConData->m_userName);
     } else {
         result                               = ERROR_CODE_WRONG_PASSWORD;
         this->m_pUserConData->m_bIsConnected = false;
@@ -88,7 +93,7 @@ MessageProtocol* DataConnection::requestGetUserProperties()
     answer.append((char)0x00);
 
 
-    qInfo().noquote() << QString("User %1 getting user properties %2").arg(this->m_pUserConData->m_userName, readableName);
+    qCInfo(logRequest).noquote() << QString("User %1 getting user properties %2").arg(this->m_pUserConData->m_userName, readableName);
 
     MessageProtocol* ack = new MessageProtocol(OP_CODE_CMD_RES::ACK_GET_USER_PROPS, answer);
 
@@ -105,7 +110,7 @@ MessageProtocol* DataConnection::requestGetUserProperties()
 MessageProtocol* DataConnection::requestUserChangeLogin(MessageProtocol* msg)
 {
     if (msg->getDataLength() <= 8) {
-        qWarning() << QString("Getting no user login data from %1").arg(this->m_pUserConData->m_userName);
+        qWarning() << QString("User %1 sent no login data").arg(this->m_pUserConData->m_userName);
         return NULL;
     }
 
@@ -149,7 +154,7 @@ MessageProtocol* DataConnection::requestUserChangeLogin(MessageProtocol* msg)
 MessageProtocol* DataConnection::requestUserChangeReadname(MessageProtocol* msg)
 {
     if (msg->getDataLength() <= 4) {
-        qWarning() << QString("Getting no readname from %1").arg(this->m_pUserConData->m_userName);
+        qWarning() << QString("User %1 sent no readname").arg(this->m_pUserConData->m_userName);
         return NULL;
     }
 
@@ -177,7 +182,7 @@ MessageProtocol* DataConnection::requestUserChangeReadname(MessageProtocol* msg)
 MessageProtocol* DataConnection::requestGetProgramVersion(MessageProtocol* msg)
 {
     if (msg->getDataLength() <= 6) {
-        qWarning() << QString("Getting no version data from %1").arg(this->m_pUserConData->m_userName);
+        qWarning() << QString("User %1 sent no version data").arg(this->m_pUserConData->m_userName);
         return NULL;
     }
 
@@ -187,7 +192,7 @@ MessageProtocol* DataConnection::requestGetProgramVersion(MessageProtocol* msg)
     if (actLength > msg->getDataLength())
         return new MessageProtocol(OP_CODE_CMD_RES::ACK_GET_VERSION, ERROR_CODE_WRONG_SIZE);
     QString remVersion(QByteArray(pData + 6, actLength));
-    qInfo().noquote() << QString("Version from %1 = %2:0x%3").arg(this->m_pUserConData->m_userName).arg(remVersion, QString::number(intVersion, 16));
+    qCInfo(logRequest).noquote() << QString("User %1 has version %2:0x%3").arg(this->m_pUserConData->m_userName).arg(remVersion, QString::number(intVersion, 16));
     QByteArray  ownVersion;
     QDataStream wVersion(&ownVersion, QIODevice::WriteOnly);
     wVersion.setByteOrder(QDataStream::LittleEndian);
@@ -234,17 +239,20 @@ MessageProtocol* DataConnection::requestGetProgramVersion(MessageProtocol* msg)
  * 28+X qutin16     sizePack2       2
  */
 
+/* since MSG_HEADER_VERSION_COMPRESS answers bigger than COMPRESS_THRESHOLD_SIZE are sent
+ * compressed with the team names as dictionary, see messagecompression.h */
+
 #define GAMES_OFFSET (1 + 1 + 8 + 4) // sIndex + comp + datetime + index
 
 MessageProtocol* DataConnection::requestGetGamesList(MessageProtocol* msg)
 {
     if (msg->getDataLength() != 4 && msg->getVersion() < MSG_HEADER_VERSION_GAME_LIST) {
-        qWarning() << QString("Error getting wrong message size %1 for get games list from %2, expected 4")
+        qWarning() << QString("User %2 sent wrong message size %1 for get games list, expected 4")
                           .arg(msg->getDataLength())
                           .arg(this->m_pUserConData->m_userName);
         return new MessageProtocol(OP_CODE_CMD_RES::ACK_GET_GAMES_LIST, ERROR_CODE_WRONG_SIZE);
     } else if (msg->getVersion() >= MSG_HEADER_VERSION_GAME_LIST && msg->getDataLength() != 12) {
-        qWarning() << QString("Error getting wrong message size %1 for get games list from %2, expected 12")
+        qWarning() << QString("User %2 sent wrong message size %1 for get games list, expected 12")
                           .arg(msg->getDataLength())
                           .arg(this->m_pUserConData->m_userName);
         return new MessageProtocol(OP_CODE_CMD_RES::ACK_GET_GAMES_LIST, ERROR_CODE_WRONG_SIZE);
@@ -288,7 +296,8 @@ MessageProtocol* DataConnection::requestGetGamesList(MessageProtocol* msg)
         wAckArray << qint16(updateIndex);
     }
 
-    quint16 numbOfLoadedGames = 0;
+    QStringList teamNames;
+    quint16     numbOfLoadedGames = 0;
     for (qint32 i = startValue; i < numbOfGames; i++) {
         GamesPlay* pGame = (GamesPlay*)(this->m_pGlobalData->m_GamesList.getRequestConfigItemFromListIndex(i));
         if (pGame == NULL)
@@ -316,6 +325,11 @@ MessageProtocol* DataConnection::requestGetGamesList(MessageProtocol* msg)
             wAckArray << freeTickets << blockTickets << reservedTickets;
         }
 
+        if (!teamNames.contains(pGame->m_itemName))
+            teamNames.append(pGame->m_itemName);
+        if (!teamNames.contains(pGame->m_away))
+            teamNames.append(pGame->m_away);
+
         numbOfLoadedGames++;
         ackArray.append(game);
     }
@@ -327,9 +341,9 @@ MessageProtocol* DataConnection::requestGetGamesList(MessageProtocol* msg)
         wAckArray << lastUpdateGameFromServer;
     }
 
-    qInfo().noquote() << QString("User %1 request Games List with %2 entries").arg(this->m_pUserConData->m_userName).arg(numbOfLoadedGames);
+    qCInfo(logRequest).noquote() << QString("User %1 request Games List with %2 entries").arg(this->m_pUserConData->m_userName).arg(numbOfLoadedGames);
 
-    return new MessageProtocol(OP_CODE_CMD_RES::ACK_GET_GAMES_LIST, ackArray);
+    return MessageCompression::createMessage(OP_CODE_CMD_RES::ACK_GET_GAMES_LIST, ackArray, teamNames, msg->getVersion());
 }
 
 /* answer
@@ -351,7 +365,7 @@ MessageProtocol* DataConnection::requestGetGamesList(MessageProtocol* msg)
 MessageProtocol* DataConnection::requestGetGamesInfoList(MessageProtocol* msg)
 {
     if (msg->getDataLength() != 8) {
-        qWarning() << QString("Error getting wrong message size %1 for get games info list from %2")
+        qWarning() << QString("User %2 sent wrong message size %1 for get games info list")
                           .arg(msg->getDataLength())
                           .arg(this->m_pUserConData->m_userName);
         return new MessageProtocol(OP_CODE_CMD_RES::ACK_GET_GAMES_INFO_LIST, ERROR_CODE_WRONG_SIZE);
@@ -441,7 +455,7 @@ MessageProtocol* DataConnection::requestGetGamesInfoList(MessageProtocol* msg)
         offset += sizeof(quint16);
     }
 
-    qInfo().noquote() << QString("User %1 request Games Info List").arg(this->m_pUserConData->m_userName);
+    qCInfo(logRequest).noquote() << QString("User %1 request Games Info List").arg(this->m_pUserConData->m_userName);
 
     return new MessageProtocol(OP_CODE_CMD_RES::ACK_GET_GAMES_INFO_LIST, &buffer[0], offset);
 }
@@ -453,7 +467,7 @@ MessageProtocol* DataConnection::requestGetGamesInfoList(MessageProtocol* msg)
 MessageProtocol* DataConnection::requestSetFixedGameTime(MessageProtocol* msg)
 {
     if (msg->getDataLength() != 8) {
-        qWarning() << QString("Error getting wrong message size %1 for set games fixed time from %2")
+        qWarning() << QString("User %2 sent wrong message size %1 for set games fixed time")
                           .arg(msg->getDataLength())
                           .arg(this->m_pUserConData->m_userName);
         return new MessageProtocol(OP_CODE_CMD_RES::ACK_SET_FIXED_GAME_TIME, ERROR_CODE_WRONG_SIZE);
@@ -467,13 +481,14 @@ MessageProtocol* DataConnection::requestSetFixedGameTime(MessageProtocol* msg)
     fixedTime = qFromLittleEndian(fixedTime);
 
     int rValue = this->m_pGlobalData->m_GamesList.changeScheduledValue(gameIndex, fixedTime);
-    if (rValue == ERROR_CODE_SUCCESS)
-        qInfo().noquote() << QString("Update scheduled fixed time to %1 from game %2 from %3")
-                                 .arg(fixedTime)
-                                 .arg(gameIndex)
-                                 .arg(this->m_pUserConData->m_userName);
-    else
-        qWarning().noquote() << QString("Could not update scheduled fixed time to %1 from game %2 from %3")
+    if (rValue == ERROR_CODE_SUCCESS) {
+        qCInfo(logRequest).noquote() << QString("User %3 updated scheduled fixed time of game %2 to %1")
+                                            .arg(fixedTime)
+                                            .arg(gameIndex)
+                                            .arg(this->m_pUserConData->m_userName);
+        this->m_pGlobalData->sendPushChange(PUSH_GAME_CHANGED, gameIndex);
+    } else
+        qWarning().noquote() << QString("User %3 could not update scheduled fixed time of game %2 to %1")
                                     .arg(fixedTime)
                                     .arg(gameIndex)
                                     .arg(this->m_pUserConData->m_userName);
@@ -498,7 +513,7 @@ MessageProtocol* DataConnection::requestSetFixedGameTime(MessageProtocol* msg)
 MessageProtocol* DataConnection::requestGetTicketsList(MessageProtocol* msg)
 {
     if (msg->getVersion() >= MSG_HEADER_VERSION_GAME_LIST && msg->getDataLength() != 8) {
-        qWarning() << QString("Error getting wrong message size %1 for get ticket list from %2, expected 8")
+        qWarning() << QString("User %2 sent wrong message size %1 for get ticket list, expected 8")
                           .arg(msg->getDataLength())
                           .arg(this->m_pUserConData->m_userName);
         return new MessageProtocol(OP_CODE_CMD_RES::ACK_GET_TICKETS_LIST, ERROR_CODE_WRONG_SIZE);
@@ -545,7 +560,7 @@ MessageProtocol* DataConnection::requestGetTicketsList(MessageProtocol* msg)
         wAckArray << this->m_pGlobalData->m_SeasonTicket.getLastUpdateTime();
     }
 
-    qInfo().noquote() << QString("User %1 request Ticket List with %2 entries").arg(this->m_pUserConData->m_userName).arg(numbOfTickets);
+    qCInfo(logRequest).noquote() << QString("User %1 request Ticket List with %2 entries").arg(this->m_pUserConData->m_userName).arg(numbOfTickets);
 
     return new MessageProtocol(OP_CODE_CMD_RES::ACK_GET_TICKETS_LIST, ackArray);
 }
@@ -574,9 +589,9 @@ MessageProtocol* DataConnection::requestAddSeasonTicket(MessageProtocol* msg)
     qint32  userIndex = this->m_pGlobalData->m_UserList.getItemIndex(userName);
     qint32  rCode     = this->m_pGlobalData->m_SeasonTicket.addNewSeasonTicket(userName, userIndex, ticketName, discount);
     if (rCode > ERROR_CODE_NO_ERROR) {
-        qInfo().noquote() << QString("User %1 added SeasonTicket %2")
-                                 .arg(this->m_pUserConData->m_userName)
-                                 .arg(ticketName);
+        qCInfo(logRequest).noquote() << QString("User %1 added SeasonTicket %2")
+                                            .arg(this->m_pUserConData->m_userName)
+                                            .arg(ticketName);
         return new MessageProtocol(OP_CODE_CMD_RES::ACK_ADD_TICKET, ERROR_CODE_SUCCESS);
     }
     return new MessageProtocol(OP_CODE_CMD_RES::ACK_ADD_TICKET, rCode);
@@ -598,9 +613,9 @@ MessageProtocol* DataConnection::requestRemoveSeasonTicket(MessageProtocol* msg)
     quint32     index = qFromLittleEndian(*((quint32*)pData));
 
     if ((rCode = this->m_pGlobalData->m_SeasonTicket.removeItem(index)) == ERROR_CODE_SUCCESS) {
-        qInfo().noquote() << QString("User %1 removed SeasonTicket %2")
-                                 .arg(this->m_pUserConData->m_userName)
-                                 .arg(index);
+        qCInfo(logRequest).noquote() << QString("User %1 removed SeasonTicket %2")
+                                            .arg(this->m_pUserConData->m_userName)
+                                            .arg(index);
         return new MessageProtocol(OP_CODE_CMD_RES::ACK_REMOVE_TICKET, ERROR_CODE_SUCCESS);
     }
     return new MessageProtocol(OP_CODE_CMD_RES::ACK_REMOVE_TICKET, rCode);
@@ -629,9 +644,9 @@ MessageProtocol* DataConnection::requestNewPlaceSeasonTicket(MessageProtocol* ms
     QString newPlace(QByteArray(pData + 6, actLength));
 
     if ((rCode = this->m_pGlobalData->m_SeasonTicket.changeSeasonTicketInfos(index, -1, "", newPlace)) == ERROR_CODE_SUCCESS) {
-        qInfo().noquote() << QString("User %1 changed SeasonTicket place to %2")
-                                 .arg(this->m_pUserConData->m_userName)
-                                 .arg(newPlace);
+        qCInfo(logRequest).noquote() << QString("User %1 changed SeasonTicket place to %2")
+                                            .arg(this->m_pUserConData->m_userName)
+                                            .arg(newPlace);
         return new MessageProtocol(OP_CODE_CMD_RES::ACK_NEW_TICKET_PLACE, ERROR_CODE_SUCCESS);
     }
     return new MessageProtocol(OP_CODE_CMD_RES::ACK_NEW_TICKET_PLACE, rCode);
@@ -665,9 +680,9 @@ MessageProtocol* DataConnection::requestChangeSeasonTicket(MessageProtocol* msg)
     QString place(QByteArray(pData + offset));
 
     if ((rCode = this->m_pGlobalData->m_SeasonTicket.changeSeasonTicketInfos(ticketIndex, discount, name, place)) == ERROR_CODE_SUCCESS) {
-        qInfo().noquote() << QString("User %1 changed SeasonTicket infos from index %2")
-                                 .arg(this->m_pUserConData->m_userName)
-                                 .arg(ticketIndex);
+        qCInfo(logRequest).noquote() << QString("User %1 changed SeasonTicket infos from index %2")
+                                            .arg(this->m_pUserConData->m_userName)
+                                            .arg(ticketIndex);
         return new MessageProtocol(OP_CODE_CMD_RES::ACK_CHANGE_TICKET, ERROR_CODE_SUCCESS);
     }
     return new MessageProtocol(OP_CODE_CMD_RES::ACK_CHANGE_TICKET, rCode);
@@ -701,10 +716,11 @@ MessageProtocol* DataConnection::requestChangeStateSeasonTicket(MessageProtocol*
     QString reserveName(QByteArray(pData + 14, actLength));
 
     if ((rCode = this->m_pGlobalData->requestChangeStateSeasonTicket(ticketIndex, gameIndex, state, reserveName, this->m_pUserConData->m_userName)) == ERROR_CODE_SUCCESS) {
-        qInfo().noquote() << QString("User %1 set SeasonTicket %2 state to %3")
-                                 .arg(this->m_pUserConData->m_userName)
-                                 .arg(this->m_pGlobalData->m_SeasonTicket.getItemName(ticketIndex))
-                                 .arg(state);
+        qCInfo(logRequest).noquote() << QString("User %1 set SeasonTicket %2 state to %3")
+                                            .arg(this->m_pUserConData->m_userName)
+                                            .arg(this->m_pGlobalData->m_SeasonTicket.getItemName(ticketIndex))
+                                            .arg(state);
+        this->m_pGlobalData->sendPushChange(PUSH_TICKET_CHANGED, gameIndex);
         return new MessageProtocol(OP_CODE_CMD_RES::ACK_STATE_CHANGE_SEASON_TICKET, ERROR_CODE_SUCCESS);
     }
     return new MessageProtocol(OP_CODE_CMD_RES::ACK_STATE_CHANGE_SEASON_TICKET, rCode);
@@ -790,6 +806,7 @@ MessageProtocol* DataConnection::requestChangeGame(MessageProtocol* msg)
     if (index > 0 && index != result) {
         qWarning().noquote() << QString("user %1 tried to changed game %2, but added game %3").arg(this->m_pUserConData->m_userName).arg(index).arg(result);
     }
+    this->m_pGlobalData->sendPushChange(PUSH_GAME_CHANGED, result);
     return new MessageProtocol(OP_CODE_CMD_RES::ACK_CHANGE_GAME, ERROR_CODE_SUCCESS);
 }
 
@@ -820,9 +837,10 @@ MessageProtocol* DataConnection::requestChangeMeetingInfo(MessageProtocol* msg)
     QString info(QByteArray(pData + offset));
 
     if ((rCode = this->m_pGlobalData->requestChangeMeetingInfo(gameIndex, 0, when, where, info)) == ERROR_CODE_SUCCESS) {
-        qInfo().noquote() << QString("User %1 set MeetingInfo of game %2")
-                                 .arg(this->m_pUserConData->m_userName)
-                                 .arg(this->m_pGlobalData->m_GamesList.getItemName(gameIndex));
+        qCInfo(logRequest).noquote() << QString("User %1 set MeetingInfo of game %2")
+                                            .arg(this->m_pUserConData->m_userName)
+                                            .arg(this->m_pGlobalData->m_GamesList.getItemName(gameIndex));
+        this->m_pGlobalData->sendPushChange(PUSH_MEETING_CHANGED, gameIndex);
     }
     return new MessageProtocol(OP_CODE_CMD_RES::ACK_CHANGE_MEETING_INFO, rCode);
 }
@@ -848,17 +866,17 @@ MessageProtocol* DataConnection::requestGetMeetingInfo(MessageProtocol* msg)
 
     if ((rCode = this->m_pGlobalData->requestGetMeetingInfo(gameIndex, 0, &buffer[0], size)) == ERROR_CODE_SUCCESS) {
         GamesPlay* pGame = (GamesPlay*)this->m_pGlobalData->m_GamesList.getItem(gameIndex);
-        qInfo().noquote() << QString("User %1 got MeetingInfo of game %2:%3:%4")
-                                 .arg(this->m_pUserConData->m_userName)
-                                 .arg(gameIndex)
-                                 .arg(pGame->m_competition)
-                                 .arg(pGame->m_saisonIndex);
+        qCInfo(logRequest).noquote() << QString("User %1 got MeetingInfo of game %2:%3:%4")
+                                            .arg(this->m_pUserConData->m_userName)
+                                            .arg(gameIndex)
+                                            .arg(pGame->m_competition)
+                                            .arg(pGame->m_saisonIndex);
         return new MessageProtocol(OP_CODE_CMD_RES::ACK_GET_MEETING_INFO, &buffer[0], size);
     }
-    qInfo().noquote() << QString("User %1 got MeetingInfo of game %2 with result %3")
-                             .arg(this->m_pUserConData->m_userName)
-                             .arg(this->m_pGlobalData->m_GamesList.getItemName(gameIndex))
-                             .arg(rCode);
+    qCInfo(logRequest).noquote() << QString("User %1 got MeetingInfo of game %2 with result %3")
+                                        .arg(this->m_pUserConData->m_userName)
+                                        .arg(this->m_pGlobalData->m_GamesList.getItemName(gameIndex))
+                                        .arg(rCode);
     return new MessageProtocol(OP_CODE_CMD_RES::ACK_GET_MEETING_INFO, rCode);
 }
 
@@ -886,10 +904,42 @@ MessageProtocol* DataConnection::requestAcceptMeeting(MessageProtocol* msg)
     QString name(QByteArray((char*)(pData + 3)));
 
     if ((rCode = this->m_pGlobalData->requestAcceptMeetingInfo(gameIndex, 0, acceptValue, acceptIndex, name, this->m_pUserConData->m_userName)) == ERROR_CODE_SUCCESS) {
-        qInfo().noquote() << QString("User %1 accepted MeetingInfo of game %2 with value %3")
-                                 .arg(this->m_pUserConData->m_userName)
-                                 .arg(this->m_pGlobalData->m_GamesList.getItemName(gameIndex))
-                                 .arg(acceptValue);
+        qCInfo(logRequest).noquote() << QString("User %1 accepted MeetingInfo of game %2 with value %3")
+                                            .arg(this->m_pUserConData->m_userName)
+                                            .arg(this->m_pGlobalData->m_GamesList.getItemName(gameIndex))
+                                            .arg(acceptValue);
+        this->m_pGlobalData->sendPushChange(PUSH_MEETING_CHANGED, gameIndex);
     }
     return new MessageProtocol(OP_CODE_CMD_RES::ACK_ACCEPT_MEETING, rCode);
 }
+
+/*  request
+ * 0   quint32      lastSequence    4   // last push the app received
+ */
+/*  answer
+ * 0   quint32      result          4
+ * 4   quint32      sequence        4   // last push the server sent
+ */
+MessageProtocol* DataConnection::requestSubscribePush(MessageProtocol* msg)
+{
+    if (msg->getDataLength() != 4) {
+        qWarning() << QString("Wrong message size for subscribe push for user %1").arg(this->m_pUserConData->m_userName);
+        return new MessageProtocol(OP_CODE_CMD_RES::ACK_SUBSCRIBE_PUSH, ERROR_CODE_WRONG_SIZE);
+    }
+
+    quint32 lastSequence = qFromLittleEndian(*(quint32*)msg->getPointerToData());
+
+    if (!this->m_pUserConData->m_bPushSubscribed)
+        qCInfo(logRequest).noquote() << QString("User %1 subscribed for push notifications").arg(this->m_pUserConData->m_userName);
+    else if (lastSequence != this->m_pUserConData->m_pushSequence)
+        qCInfo(logRequest).noquote() << QString("User %1 missed push notifications %2 to %3")
+                                            .arg(this->m_pUserConData->m_userName)
+                                            .arg(lastSequence + 1)
+                                            .arg(this->m_pUserConData->m_pushSequence);
+    this->m_pUserConData->m_bPushSubscribed = true;
+
+    quint32 data[2];
+    data[0] = qToLittleEndian(quint32(ERROR_CODE_SUCCESS));
+    data[1] = qToLittleEndian(this->m_pUserConData->m_pushSequence);
+    return new MessageProtocol(OP_CODE_CMD_RES::ACK_SUBSCRIBE_PUSH, (char*)&data[0], sizeof(quint32) * 2);
+}
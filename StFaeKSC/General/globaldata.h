@@ -20,15 +20,18 @@
 #define GLOBALDATA_H
 
 #include <QtCore/QList>
+#include <QtCore/QObject>
 
 #include "../Data/availablegameticket.h"
 #include "../Data/games.h"
 #include "../Data/listeduser.h"
 #include "../Data/meetinginfo.h"
 #include "../Data/seasonticket.h"
+#include "serverstatistics.h"
 
-class GlobalData
+class GlobalData : public QObject
 {
+    Q_OBJECT
 public:
     GlobalData();
 
@@ -47,11 +50,17 @@ public:
     quint16 getAcceptedNumber(const quint32 gamesIndex, const quint32 state);
     quint16 getMeetingInfoValue(const quint32 gamesIndex);
 
+    void sendPushChange(const quint32 type, const quint32 gameIndex) { emit this->signalPushChange(type, gameIndex); }
+
     ListedUser                   m_UserList;
     Games                        m_GamesList;
     SeasonTicket                 m_SeasonTicket;
     QList<AvailableGameTickets*> m_availableTickets;
     QList<MeetingInfo*>          m_meetingInfos;
+    ServerStatistics             m_statistics;
+
+signals:
+    void signalPushChange(quint32 type, quint32 gameIndex);
 };
 
 #endif // GLOBALDATA_H
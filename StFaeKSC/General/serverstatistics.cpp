@@ -0,0 +1,156 @@
+/*
+*	This file is part of StamOrga
+*   Copyright (C) 2017 Markus Schneider
+*
+*	This program is free software; you can redistribute it and/or modify
+*   it under the terms of the GNU General Public License as published by
+*   the Free Software Foundation; either version 3 of the License, or
+*   (at your option) any later version.
+*
+*	StamOrga is distributed in the hope that it will be useful,
+*    but WITHOUT ANY WARRANTY; without even the implied warranty of
+*    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+*    GNU General Public License for more details.
+
+*    You should have received a copy of the GNU General Public License
+*    along with StamOrga.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include <QtCore/QDateTime>
+#include <QtCore/QFile>
+#include <QtCore/QList>
+#include <QtCore/QPair>
+
+#include <algorithm>
+
+#include "serverstatistics.h"
+
+ServerStatistics::ServerStatistics()
+{
+    this->m_requests      = 0;
+    this->m_totalRequests = 0;
+    this->m_connections   = 0;
+    this->m_pendingPushes  = 0;
+    this->m_maxMasterQueue = 0;
+    this->m_maxDataQueue   = 0;
+    this->m_latencies.reserve(STAT_MAX_LATENCY_SAMPLES);
+
+    this->m_window.start();
+    this->m_upTime.start();
+}
+
+void ServerStatistics::addRequest(const QString& userName, quint32 opCode, qint64 durationUSec)
+{
+    QMutexLocker lock(&this->m_mutex);
+
+    this->m_requests++;
+    this->m_totalRequests++;
+    this->m_opCodeRequests[opCode]++;
+    this->m_userRequests[userName]++;
+    if (this->m_latencies.size() < STAT_MAX_LATENCY_SAMPLES)
+        this->m_latencies.append(durationUSec);
+}
+
+void ServerStatistics::setConnectionCount(int count)
+{
+    QMutexLocker lock(&this->m_mutex);
+    this->m_connections = count;
+}
+
+void ServerStatistics::addPendingPushes(int diff)
+{
+    QMutexLocker lock(&this->m_mutex);
+    this->m_pendingPushes += diff;
+}
+
+void ServerStatistics::addQueueDepth(int depth, bool bMasterPort)
+{
+    QMutexLocker lock(&this->m_mutex);
+    if (bMasterPort)
+        this->m_maxMasterQueue = qMax(this->m_maxMasterQueue, depth);
+    else
+        this->m_maxDataQueue = qMax(this->m_maxDataQueue, depth);
+}
+
+static QString getPercentile(QVector<qint64>& values, int percent)
+{
+    if (values.isEmpty())
+        return "-";
+
+    int index = (values.size() - 1) * percent / 100;
+    std::nth_element(values.begin(), values.begin() + index, values.end());
+    return QString::number(values[index] / 1000.0, 'f', 2);
+}
+
+QString ServerStatistics::getReport()
+{
+    QMutexLocker lock(&this->m_mutex);
+
+    double seconds = this->m_window.restart() / 1000.0;
+    if (seconds <= 0)
+        seconds = 1;
+
+    QString report;
+    report.append(QString("StFaeKSC - %1, up %2 min, %3 requests total\n")
+                      .arg(QDateTime::currentDateTime().toString("hh:mm:ss"))
+                      .arg(this->m_upTime.elapsed() / 60000)
+                      .arg(this->m_totalRequests));
+
+    qint64 memory = getMemoryUsage();
+    report.append(QString("Connections: %1   Pushes pending: %2   Memory: %3\n")
+                      .arg(this->m_connections)
+                      .arg(this->m_pendingPushes)
+                      .arg(memory > 0 ? QString("%1 MB").arg(memory / 1024.0 / 1024.0, 0, 'f', 1) : QString("-")));
+
+    report.append(QString("Queue depth max: master port %1   data ports %2\n")
+                      .arg(this->m_maxMasterQueue)
+                      .arg(this->m_maxDataQueue));
+
+    report.append(QString("Requests: %1/s   Latency ms p50 %2  p90 %3  p99 %4  max %5\n\n")
+                      .arg(this->m_requests / seconds, 0, 'f', 1)
+                      .arg(getPercentile(this->m_latencies, 50))
+                      .arg(getPercentile(this->m_latencies, 90))
+                      .arg(getPercentile(this->m_latencies, 99))
+                      .arg(getPercentile(this->m_latencies, 100)));
+
+    report.append(QString("%1 %2\n").arg("OpCode", -12).arg("req/s", 8));
+    QList<quint32> opCodes = this->m_opCodeRequests.keys();
+    std::sort(opCodes.begin(), opCodes.end());
+    foreach (quint32 opCode, opCodes) {
+        report.append(QString("0x%1 %2\n")
+                          .arg(opCode, 8, 16, QChar('0'))
+                          .arg(this->m_opCodeRequests[opCode] / seconds, 10, 'f', 1));
+    }
+
+    report.append(QString("\n%1 %2\n").arg("User", -20).arg("req/s", 8));
+    QList<QPair<quint32, QString>> users;
+    for (QHash<QString, quint32>::const_iterator it = this->m_userRequests.constBegin(); it != this->m_userRequests.constEnd(); ++it)
+        users.append(qMakePair(it.value(), it.key()));
+    std::sort(users.begin(), users.end(), [](const QPair<quint32, QString>& a, const QPair<quint32, QString>& b) { return a.first > b.first; });
+    for (int i = 0; i < users.size() && i < STAT_TOP_USERS; i++)
+        report.append(QString("%1 %2\n").arg(users[i].second, -20).arg(users[i].first / seconds, 8, 'f', 1));
+
+    this->m_opCodeRequests.clear();
+    this->m_userRequests.clear();
+    this->m_latencies.clear();
+    this->m_requests       = 0;
+    this->m_maxMasterQueue = 0;
+    this->m_maxDataQueue   = 0;
+
+    return report;
+}
+
+/* Resident memory of the process in bytes, 0 when it is not known */
+qint64 ServerStatistics::getMemoryUsage()
+{
+#ifdef Q_OS_LINUX
+    QFile status("/proc/self/status");
+    if (status.open(QFile::ReadOnly)) {
+        foreach (QByteArray line, status.readAll().split('\n')) {
+            if (line.startsWith("VmRSS:"))
+                return line.mid(6).trimmed().split(' ').value(0).toLongLong() * 1024;
+        }
+    }
+#endif
+    return 0;
+}
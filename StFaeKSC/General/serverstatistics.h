@@ -0,0 +1,68 @@
+/*
+*	This file is part of StamOrga
+*   Copyright (C) 2017 Markus Schneider
+*
+*	This program is free software; you can redistribute it and/or modify
+*   it under the terms of the GNU General Public License as published by
+*   the Free Software Foundation; either version 3 of the License, or
+*   (at your option) any later version.
+*
+*	StamOrga is distributed in the hope that it will be useful,
+*    but WITHOUT ANY WARRANTY; without even the implied warranty of
+*    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+*    GNU General Public License for more details.
+
+*    You should have received a copy of the GNU General Public License
+*    along with StamOrga.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#ifndef SERVERSTATISTICS_H
+#define SERVERSTATISTICS_H
+
+#include <QtCore/QElapsedTimer>
+#include <QtCore/QHash>
+#include <QtCore/QMutex>
+#include <QtCore/QString>
+#include <QtCore/QVector>
+
+// clang-format off
+#define STAT_MAX_LATENCY_SAMPLES    10000
+#define STAT_TOP_USERS              10
+// clang-format on
+
+/*
+ * Counters of the server for the console command top. The request counters are collected
+ * between two reports, getReport returns the rates of this window and starts a new one.
+ */
+class ServerStatistics
+{
+public:
+    ServerStatistics();
+
+    void addRequest(const QString& userName, quint32 opCode, qint64 durationUSec);
+    void setConnectionCount(int count);
+    void addPendingPushes(int diff);
+    void addQueueDepth(int depth, bool bMasterPort);
+
+    QString getReport();
+
+private:
+    QMutex        m_mutex;
+    QElapsedTimer m_window;
+    QElapsedTimer m_upTime;
+
+    QHash<quint32, quint32> m_opCodeRequests;
+    QHash<QString, quint32> m_userRequests;
+    QVector<qint64>         m_latencies;
+    quint32                 m_requests;
+    quint64                 m_totalRequests;
+
+    int m_connections;
+    int m_pendingPushes;
+    int m_maxMasterQueue; /* most datagrams waiting at one read, within the window */
+    int m_maxDataQueue;
+
+    static qint64 getMemoryUsage();
+};
+
+#endif // SERVERSTATISTICS_H
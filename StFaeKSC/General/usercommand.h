@@ -20,6 +20,7 @@
 #define USERCOMMAND_H
 
 #include <QtCore/QDebug>
+#include <QtCore/QLoggingCategory>
 #include <QtCore/QStringList>
 
 #include <iostream>
@@ -80,6 +81,35 @@ public:
         if (list.size() < 2 || list.value(0) != "log")
             return log->showLoggingInfo(5);
 
+        if (list.value(1) == "find" && list.size() > 2) {
+            QStringList lines;
+            if (log->findLogLines(QStringList(list.mid(2)).join(' '), lines) != ERROR_CODE_SUCCESS) {
+                std::cout << "Wrong query, use user=%NAME% game=%INDEX% since=%hh:mm%" << std::endl;
+                return ERROR_CODE_WRONG_PARAMETER;
+            }
+            foreach (const QString& line, lines)
+                std::cout << line.toStdString() << std::endl;
+            std::cout << lines.size() << " lines found" << std::endl;
+            return lines.size();
+        }
+
+        if (list.value(1) == "rules" && list.size() == 3) {
+            /* e.g. "log rules stamorga.request.info=false;*.debug=false" */
+            QLoggingCategory::setFilterRules(list.value(2).replace(';', '\n'));
+            CONSOLE_INFO(QString("Set logging rules %1").arg(list.value(2)));
+            return ERROR_CODE_SUCCESS;
+        }
+
+        if (list.value(1) == "decode" && list.size() == 3) {
+            QString text;
+            if (!Logging::readLogFile(list.value(2), text)) {
+                CONSOLE_WARNING(QString("Could not read log file %1").arg(list.value(2)));
+                return ERROR_CODE_COMMON;
+            }
+            std::cout << text.toStdString() << std::flush;
+            return ERROR_CODE_SUCCESS;
+        }
+
         bool ok;
         int  numb = list.value(1).toInt(&ok);
         if (ok)
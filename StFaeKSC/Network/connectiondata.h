@@ -29,6 +29,8 @@ struct UserConData {
     QString      m_userName;
     QString      m_randomLogin;
     bool         m_bIsConnected;
+    bool         m_bPushSubscribed;
+    quint32      m_pushSequence;
 };
 
 #endif // CONNECTIONDATA_H
@@ -16,6 +16,8 @@
 *    along with StamOrga.  If not, see <http://www.gnu.org/licenses/>.
 */
 
+#include <QtCore/QElapsedTimer>
+
 #include "udpdataserver.h"
 #include "../Common/General/globalfunctions.h"
 #include "../Common/General/globaltiming.h"
@@ -53,6 +55,13 @@ int UdpDataServer::DoBackgroundWork()
     connect(this->m_pConResetTimer, &QTimer::timeout, this, &UdpDataServer::onConnectionResetTimeout);
     this->m_pConResetTimer->start();
 
+    this->m_pPushRetryTimer = new QTimer();
+    this->m_pPushRetryTimer->setSingleShot(true);
+    this->m_pPushRetryTimer->setInterval(PUSH_RETRY_TIMEOUT_MSEC);
+    connect(this->m_pPushRetryTimer, &QTimer::timeout, this, &UdpDataServer::onPushRetryTimeout);
+
+    connect(this->m_pGlobalData, &GlobalData::signalPushChange, this, &UdpDataServer::onPushChange);
+
     this->m_pDataConnection = new DataConnection(this->m_pGlobalData);
     this->m_pDataConnection->setUserConnectionData(this->m_pUsrConData);
 
@@ -63,7 +72,9 @@ void UdpDataServer::readyReadSocketPort()
 {
     this->m_pConResetTimer->start();
 
+    int datagrams = 0;
     while (this->m_pUdpSocket->hasPendingDatagrams()) {
+        datagrams++;
         QHostAddress sender;
         quint16      port;
         QByteArray   datagram;
@@ -76,6 +87,7 @@ void UdpDataServer::readyReadSocketPort()
             }
         }
     }
+    this->m_pGlobalData->m_statistics.addQueueDepth(datagrams, false);
 
     this->checkNewOncomingData();
 }
@@ -96,43 +108,187 @@ void UdpDataServer::onConnectionResetTimeout()
 void UdpDataServer::checkNewOncomingData()
 {
     MessageProtocol* msg;
+    QElapsedTimer    timer;
     while ((msg = this->m_msgBuffer.GetNextMessage()) != NULL) {
 
-        MessageProtocol* ack = checkNewMessage(msg);
+        if (this->sendCachedResponse(msg)) {
+            delete msg;
+            continue;
+        }
 
-        if (ack != NULL) {
+        /* a login starts a new session of the app, its request ids can repeat older ones */
+        if (msg->getIndex() == OP_CODE_CMD_REQ::REQ_LOGIN_USER)
+            this->m_lSentResponses.clear();
 
-            quint32     sendBytes       = 0;
-            quint32     totalPacketSize = ack->getNetworkSize();
-            const char* pData           = ack->getNetworkProtocol();
-
-            do {
-                quint32 currentSendSize;
-                if ((totalPacketSize - sendBytes) > MAX_DATAGRAMM_SIZE)
-                    currentSendSize = MAX_DATAGRAMM_SIZE;
-                else
-                    currentSendSize = totalPacketSize - sendBytes;
-
-                qint64 rValue = this->m_pUdpSocket->writeDatagram(pData + sendBytes,
-                                                                  currentSendSize,
-                                                                  this->m_pUsrConData->m_sender,
-                                                                  this->m_pUsrConData->m_srcDataPort);
-                if (rValue < 0)
-                    break;
-                sendBytes += rValue;
-                //                QThread::msleep(25);
-            } while (sendBytes < totalPacketSize);
+        timer.start();
+        MessageProtocol* ack = checkNewMessage(msg);
+        this->m_pGlobalData->m_statistics.addRequest(this->m_pUsrConData->m_userName, msg->getIndex(), timer.nsecsElapsed() / 1000);
 
+        if (ack != NULL) {
+            if (msg->getVersion() >= MSG_HEADER_VERSION_REQUEST_ID) {
+                ack->setRequestId(msg->getRequestId());
+                this->storeSentResponse(msg, ack);
+            }
+            this->sendMessage(ack);
             delete ack;
         }
         delete msg;
     }
 }
 
+/*
+ * A request with the same id, command and data was already handled, the app retransmitted
+ * it because the answer got lost. Send the answer again without changing anything.
+ */
+bool UdpDataServer::sendCachedResponse(MessageProtocol* msg)
+{
+    if (msg->getVersion() < MSG_HEADER_VERSION_REQUEST_ID || msg->getRequestId() == 0)
+        return false;
+
+    for (int i = this->m_lSentResponses.size() - 1; i >= 0; i--) {
+        const SentResponse& response = this->m_lSentResponses.at(i);
+        if (response.m_requestId != msg->getRequestId() || response.m_request != msg->getIndex())
+            continue;
+        if (response.m_requestData != QByteArray::fromRawData(msg->getPointerToData(), msg->getDataLength()))
+            return false;
+
+        qInfo().noquote() << QString("User %3 retransmitted request 0x%1 with id %2, answering it again")
+                                 .arg(QString::number(msg->getIndex(), 16))
+                                 .arg(msg->getRequestId())
+                                 .arg(this->m_pUsrConData->m_userName);
+        this->sendData(response.m_response.constData(), response.m_response.size());
+        return true;
+    }
+    return false;
+}
+
+void UdpDataServer::storeSentResponse(MessageProtocol* msg, MessageProtocol* ack)
+{
+    /* The request is send again after the login, so it has to be handled then */
+    if (msg->getRequestId() == 0 || ack->getIndex() == OP_CODE_CMD_RES::ACK_NOT_LOGGED_IN)
+        return;
+
+    SentResponse response;
+    response.m_requestId   = msg->getRequestId();
+    response.m_request     = msg->getIndex();
+    response.m_requestData = QByteArray(msg->getPointerToData(), msg->getDataLength());
+    response.m_response    = QByteArray(ack->getNetworkProtocol(), ack->getNetworkSize());
+
+    this->m_lSentResponses.append(response);
+    while (this->m_lSentResponses.size() > SENT_RESPONSE_CACHE_SIZE)
+        this->m_lSentResponses.removeFirst();
+}
+
+void UdpDataServer::sendMessage(MessageProtocol* msg)
+{
+    this->sendData(msg->getNetworkProtocol(), msg->getNetworkSize());
+}
+
+void UdpDataServer::sendData(const char* pData, quint32 size)
+{
+    quint32 sendBytes = 0;
+
+    do {
+        quint32 currentSendSize;
+        if ((size - sendBytes) > MAX_DATAGRAMM_SIZE)
+            currentSendSize = MAX_DATAGRAMM_SIZE;
+        else
+            currentSendSize = size - sendBytes;
+
+        qint64 rValue = this->m_pUdpSocket->writeDatagram(pData + sendBytes,
+                                                          currentSendSize,
+                                                          this->m_pUsrConData->m_sender,
+                                                          this->m_pUsrConData->m_srcDataPort);
+        if (rValue < 0)
+            break;
+        sendBytes += rValue;
+        //                QThread::msleep(25);
+    } while (sendBytes < size);
+}
+
+/* push
+ * 0   quint32     sequence        4
+ * 4   quint32     type            4   // PushNotifyType
+ * 8   quint32     gameIndex       4
+ */
+void UdpDataServer::onPushChange(quint32 type, quint32 gameIndex)
+{
+    if (!this->m_pUsrConData->m_bPushSubscribed || this->m_pUsrConData->m_srcDataPort == 0)
+        return;
+
+    this->m_pUsrConData->m_pushSequence++;
+
+    quint32 data[3];
+    data[0] = qToLittleEndian(this->m_pUsrConData->m_pushSequence);
+    data[1] = qToLittleEndian(type);
+    data[2] = qToLittleEndian(gameIndex);
+
+    PushMessage push;
+    push.m_sequence = this->m_pUsrConData->m_pushSequence;
+    push.m_retries  = 0;
+    push.m_msg      = new MessageProtocol(OP_CODE_CMD_RES::PUSH_NOTIFY_CHANGE, (char*)&data[0], sizeof(quint32) * 3);
+    this->m_lPushPending.append(push);
+    this->m_pGlobalData->m_statistics.addPendingPushes(1);
+
+    this->sendMessage(push.m_msg);
+    if (!this->m_pPushRetryTimer->isActive())
+        this->m_pPushRetryTimer->start();
+}
+
+void UdpDataServer::onPushRetryTimeout()
+{
+    for (int i = this->m_lPushPending.size() - 1; i >= 0; i--) {
+        PushMessage& push = this->m_lPushPending[i];
+        if (push.m_retries >= PUSH_MAX_RETRIES) {
+            /* app will notice the gap in the sequence and load the lists itself */
+            qInfo().noquote() << QString("Dropped push %1 for user %2 without acknowledge")
+                                     .arg(push.m_sequence)
+                                     .arg(this->m_pUsrConData->m_userName);
+            delete push.m_msg;
+            this->m_lPushPending.removeAt(i);
+            this->m_pGlobalData->m_statistics.addPendingPushes(-1);
+            continue;
+        }
+        push.m_retries++;
+        this->sendMessage(push.m_msg);
+    }
+
+    if (this->m_lPushPending.size() > 0)
+        this->m_pPushRetryTimer->start();
+}
+
+/* request
+ * 0   quint32     sequence        4
+ */
+void UdpDataServer::ackPushMessage(MessageProtocol* msg)
+{
+    if (msg->getDataLength() != 4)
+        return;
+
+    quint32 sequence = qFromLittleEndian(*(quint32*)msg->getPointerToData());
+    for (int i = 0; i < this->m_lPushPending.size(); i++) {
+        if (this->m_lPushPending[i].m_sequence == sequence) {
+            delete this->m_lPushPending[i].m_msg;
+            this->m_lPushPending.removeAt(i);
+            this->m_pGlobalData->m_statistics.addPendingPushes(-1);
+            break;
+        }
+    }
+
+    if (this->m_lPushPending.size() == 0)
+        this->m_pPushRetryTimer->stop();
+}
+
 MessageProtocol* UdpDataServer::checkNewMessage(MessageProtocol* msg)
 {
     MessageProtocol* ack = NULL;
 
+    /* Acknowledges of pushes are also accepted after the login timed out, no answer is sent */
+    if (msg->getIndex() == OP_CODE_CMD_REQ::REQ_ACK_PUSH) {
+        this->ackPushMessage(msg);
+        return NULL;
+    }
+
     if (this->m_pUsrConData->m_bIsConnected) {
 
         switch (msg->getIndex()) {
@@ -212,6 +368,10 @@ MessageProtocol* UdpDataServer::checkNewMessage(MessageProtocol* msg)
             ack = this->m_pDataConnection->requestAcceptMeeting(msg);
             break;
 
+        case OP_CODE_CMD_REQ::REQ_SUBSCRIBE_PUSH:
+            ack = this->m_pDataConnection->requestSubscribePush(msg);
+            break;
+
         default:
             qWarning().noquote() << QString("Unkown command 0x%1").arg(QString::number(msg->getIndex()));
             break;
@@ -241,6 +401,13 @@ UdpDataServer::~UdpDataServer()
     if (this->m_pConResetTimer != NULL)
         delete this->m_pConResetTimer;
 
+    if (this->m_pPushRetryTimer != NULL)
+        delete this->m_pPushRetryTimer;
+
+    foreach (PushMessage push, this->m_lPushPending)
+        delete push.m_msg;
+    this->m_pGlobalData->m_statistics.addPendingPushes(-this->m_lPushPending.size());
+
     if (this->m_pUdpSocket != NULL)
         delete this->m_pUdpSocket;
 }
@@ -19,6 +19,7 @@
 #ifndef UDPDATASERVER_H
 #define UDPDATASERVER_H
 
+#include <QtCore/QList>
 #include <QtCore/QString>
 #include <QtCore/QTimer>
 #include <QtNetwork/QUdpSocket>
@@ -29,6 +30,22 @@
 #include "../Common/General/backgroundworker.h"
 #include "../Common/Network/messagebuffer.h"
 
+struct PushMessage {
+    quint32          m_sequence;
+    quint32          m_retries;
+    MessageProtocol* m_msg;
+};
+
+/* Last answers, retransmitted requests get them again instead of being handled twice */
+#define SENT_RESPONSE_CACHE_SIZE 16
+
+struct SentResponse {
+    quint32    m_requestId;
+    quint32    m_request;
+    QByteArray m_requestData;
+    QByteArray m_response;
+};
+
 class UdpDataServer : public BackgroundWorker
 {
     Q_OBJECT
@@ -48,6 +65,8 @@ private slots:
     void readyReadSocketPort();
     void onConnectionResetTimeout();
     void onConnectionLoginTimeout();
+    void onPushChange(quint32 type, quint32 gameIndex);
+    void onPushRetryTimeout();
 
 private:
     GlobalData      *m_pGlobalData;
@@ -60,7 +79,18 @@ private:
     QTimer          *m_pConLoginTimer = NULL;
     QTimer          *m_pConResetTimer = NULL;
 
+    QList<PushMessage>  m_lPushPending;
+    QTimer              *m_pPushRetryTimer = NULL;
+
+    QList<SentResponse> m_lSentResponses;
+
     void checkNewOncomingData();
+    bool sendCachedResponse(MessageProtocol *msg);
+    void storeSentResponse(MessageProtocol *msg, MessageProtocol *ack);
+
+    void sendMessage(MessageProtocol *msg);
+    void sendData(const char *pData, quint32 size);
+    void ackPushMessage(MessageProtocol *msg);
 
     MessageProtocol *checkNewMessage(MessageProtocol *msg);
 };
@@ -49,7 +49,9 @@ int UdpServer::DoBackgroundWork()
 
 void UdpServer::readyReadMasterPort()
 {
+    int datagrams = 0;
     while (this->m_pUdpMasterSocket->hasPendingDatagrams()) {
+        datagrams++;
         QHostAddress sender;
         quint16      port;
         QByteArray   datagram;
@@ -64,14 +66,18 @@ void UdpServer::readyReadMasterPort()
                 con.userConData.m_srcMasterPort = port;
                 con.userConData.m_dstDataPort   = 0;
                 con.userConData.m_srcDataPort   = 0;
-                con.pctrlUdpDataServer          = NULL;
-                con.pDataServer                 = NULL;
+                con.userConData.m_bPushSubscribed = false;
+                con.userConData.m_pushSequence    = 0;
+                con.pctrlUdpDataServer            = NULL;
+                con.pDataServer                   = NULL;
                 this->m_lUserCons.append(con);
                 usrCon = &this->m_lUserCons[this->m_lUserCons.size() - 1];
+                this->m_pGlobalData->m_statistics.setConnectionCount(this->m_lUserCons.size());
             }
             usrCon->msgBuffer.StoreNewData(datagram);
         }
     }
+    this->m_pGlobalData->m_statistics.addQueueDepth(datagrams, true);
 
     this->checkNewOncomingData();
 }
@@ -124,7 +130,7 @@ void UdpServer::checkNewOncomingData()
                     /* Create new thread if it is not running and you got a port */
                     if (this->m_lUserCons[i].userConData.m_dstDataPort && this->m_lUserCons[i].pctrlUdpDataServer == NULL) {
                         this->m_lUserCons[i].userConData.m_userName = userName;
-                        this->m_lUserCons[i].pDataServer            = new UdpDataServer(&this->m_lUserCons[i].userConData,
+                        this->m_lUserCons[i].pDataServer            = new UdpDataServer(&this->m_lUserCons[i].userConData,
                                                                              this->m_pGlobalData);
                         connect(this->m_lUserCons[i].pDataServer, &UdpDataServer::notifyConnectionTimedOut, this, &UdpServer::onConnectionTimedOut);
                         this->m_lUserCons[i].pctrlUdpDataServer = new BackgroundController();
@@ -157,6 +163,7 @@ void UdpServer::onConnectionTimedOut(quint16 port)
             this->m_lUserCons[i].pctrlUdpDataServer->Stop();
             delete this->m_lUserCons[i].pctrlUdpDataServer;
             this->m_lUserCons.removeAt(i);
+            this->m_pGlobalData->m_statistics.setConnectionCount(this->m_lUserCons.size());
             return;
         }
     }
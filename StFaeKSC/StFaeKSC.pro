@@ -33,11 +33,14 @@ SOURCES += main.cpp \
     Network/udpserver.cpp \
     ../Common/Network/messagebuffer.cpp \
     ../Common/Network/messageprotocol.cpp \
+    ../Common/Network/messagecompression.cpp \
     ../Common/Network/messagecommand.cpp \
     General/globaldata.cpp \
     General/console.cpp \
+    General/serverstatistics.cpp \
     Network/udpdataserver.cpp \
     ../Common/General/logging.cpp \
+    ../Common/General/logbinaryformat.cpp \
     ../Common/General/globalfunctions.cpp \
     General/dataconnection.cpp \
     Data/listeduser.cpp \
@@ -56,15 +59,18 @@ HEADERS += \
     Network/udpserver.h \
     ../Common/Network/messagebuffer.h \
     ../Common/Network/messageprotocol.h \
+    ../Common/Network/messagecompression.h \
     ../Common/General/globaltiming.h \
     ../Common/Network/messagecommand.h \
     General/globaldata.h \
     ../Common/General/globalfunctions.h \
     General/console.h \
+    General/serverstatistics.h \
     General/usercommand.h \
     Network/udpdataserver.h \
     Network/connectiondata.h \
     ../Common/General/logging.h \
+    ../Common/General/logbinaryformat.h \
     General/dataconnection.h \
     Data/listeduser.h \
     Data/games.h \
@@ -40,6 +40,17 @@ int main(int argc, char* argv[])
     QCoreApplication::setOrganizationDomain("watermax.com");
     QCoreApplication::setApplicationName("StFaeKSC");
 
+    /* Only print a log file as text, e.g. a binary one copied from the server */
+    if (argc > 2 && QString(argv[1]) == "-decodeLog") {
+        QString text;
+        if (!Logging::readLogFile(QString(argv[2]), text)) {
+            std::cerr << "Could not read log file " << argv[2] << std::endl;
+            return -1;
+        }
+        std::cout << text.toStdString() << std::flush;
+        return 0;
+    }
+
     GlobalData globalData;
     Console*   con = new Console(&globalData);
     globalData.initialize();
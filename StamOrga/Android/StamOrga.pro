@@ -26,9 +26,11 @@ SOURCES += main.cpp \
     ../../Common/General/backgroundcontroller.cpp \
     ../../Common/General/backgroundworker.cpp \
     ../../Common/General/logging.cpp \
+    ../../Common/General/logbinaryformat.cpp \
     ../../Common/Network/messagebuffer.cpp \
     ../../Common/Network/messagecommand.cpp \
     ../../Common/Network/messageprotocol.cpp \
+    ../../Common/Network/messagecompression.cpp \
     ../../Common/General/globalfunctions.cpp \
     ../dataconnection.cpp \
     ../datahandling.cpp \
@@ -36,7 +38,10 @@ SOURCES += main.cpp \
     ../Data/gameplay.cpp \
     ../Data/seasonticket.cpp \
     ../Data/meetinginfo.cpp \
-    ../Data/globalsettings.cpp
+    ../Data/globalsettings.cpp \
+    ../Data/localcache.cpp \
+    ../Data/gameplaymodel.cpp \
+    ../Data/seasonticketmodel.cpp
 
 
 RESOURCES += qml.qrc
@@ -71,10 +76,12 @@ HEADERS += \
     ../../Common/General/backgroundworker.h \
     ../../Common/General/config.h \
     ../../Common/General/logging.h \
+    ../../Common/General/logbinaryformat.h \
     ../../Common/General/globaltiming.h \
     ../../Common/Network/messagebuffer.h \
     ../../Common/Network/messagecommand.h \
     ../../Common/Network/messageprotocol.h \
+    ../../Common/Network/messagecompression.h \
     ../../Common/General/globalfunctions.h \
     ../dataconnection.h \
     ../datahandling.h \
@@ -83,7 +90,10 @@ HEADERS += \
     ../Data/seasonticket.h \
     ../Data/meetinginfo.h \
     ../Data/acceptmeetinginfo.h \
-    ../Data/globalsettings.h
+    ../Data/globalsettings.h \
+    ../Data/localcache.h \
+    ../Data/gameplaymodel.h \
+    ../Data/seasonticketmodel.h
 
 DISTFILES += \
     android/AndroidManifest.xml \
@@ -255,68 +255,84 @@ Rectangle {
     function showGamesInfo(gamePlayItem) {
         if (gamePlayItem !== null) {
             m_gamePlayItem = gamePlayItem
-            labelLineDate.text = gamePlayItem.timestampReadableLine();
-            labelLineWhat.text = gamePlayItem.getCompetitionLine() + gamePlayItem.competition
-            labelLineHome.text = gamePlayItem.home;
-            if (gamePlayItem.home === "KSC")
-                labelLineHome.font.letterSpacing = 2
-            labelLineAway.text = gamePlayItem.away;
-            if (gamePlayItem.away === "KSC")
-                labelLineAway.font.letterSpacing = 2
-            labelLineScore.text = gamePlayItem.score;
-
-            if (gamePlayItem.isGameInPast()) {
-                mainRectangleGame.gradColorStart = "#505050"
-                mainRectangleGame.gradColorStop = "#909090"
-                return;
-            } else if (gamePlayItem.isGameRunning()) {
-                mainRectangleGame.gradColorStart = "#f30707"
-                mainRectangleGame.gradColorStop = "#ff4747"
-            } else {
-                var comp = gamePlayItem.competitionValue();
-                if (comp === 4) { // dfb pokal
-                    mainRectangleGame.gradColorStart = "#105010"
-                    mainRectangleGame.gradColorStop = "#509050"
-                }else if (comp === 5) { // badischer pokal
-                    mainRectangleGame.gradColorStart = "#103050"
-                    mainRectangleGame.gradColorStop = "#507090"
-                } else if (comp === 6) { // TestSpiel
-                    mainRectangleGame.gradColorStart = "#101050"
-                    mainRectangleGame.gradColorStop = "#905090"
-                }
-            }
+            showGameValues({
+                home: gamePlayItem.home,
+                away: gamePlayItem.away,
+                score: gamePlayItem.score,
+                dateLine: gamePlayItem.timestampReadableLine(),
+                competitionLine: gamePlayItem.getCompetitionLine() + gamePlayItem.competition,
+                competition: gamePlayItem.competitionValue(),
+                timeFixed: gamePlayItem.timeFixed,
+                inPast: gamePlayItem.isGameInPast(),
+                running: gamePlayItem.isGameRunning(),
+                seasonTicketGame: gamePlayItem.isGameASeasonTicketGame(),
+                freeTickets: gamePlayItem.getFreeTickets(),
+                acceptedMeeting: gamePlayItem.getAcceptedMeetingCount(),
+                interestedMeeting: gamePlayItem.getInterestedMeetingCount(),
+                meetingInfo: gamePlayItem.getMeetingInfo()
+            })
+        }
+    }
 
-            var fixed = gamePlayItem.timeFixed
-//            console.log("Fixed = " + fixed);
-            if (!gamePlayItem.timeFixed)
-                labelLineTimeNotFixed.visible = true
-
-            var meetingPresent = gamePlayItem.getMeetingInfo();
-            if (meetingPresent > 0) {
-                imageMeetingIsPresent.visible = true
-                var acceptedMeeting = gamePlayItem.getAcceptedMeetingCount();
-                if (acceptedMeeting > 0) {
-                    acceptedMeetingItem.visible = true;
-                    labelAcceptedMeeting.text = acceptedMeeting;
-                }
-                var interestMeeting = gamePlayItem.getInterestedMeetingCount();
-                if (interestMeeting > 0) {
-                    interestMeetingItem.visible = true;
-                    labelInterestMeeting.text = interestMeeting;
-                }
+    /* The list of games only passes the values of its model, it does not keep the game */
+    function showGameValues(game) {
+        labelLineDate.text = game.dateLine;
+        labelLineWhat.text = game.competitionLine;
+        labelLineHome.text = game.home;
+        if (game.home === "KSC")
+            labelLineHome.font.letterSpacing = 2
+        labelLineAway.text = game.away;
+        if (game.away === "KSC")
+            labelLineAway.font.letterSpacing = 2
+        labelLineScore.text = game.score;
+
+        if (game.inPast) {
+            mainRectangleGame.gradColorStart = "#505050"
+            mainRectangleGame.gradColorStop = "#909090"
+            return;
+        } else if (game.running) {
+            mainRectangleGame.gradColorStart = "#f30707"
+            mainRectangleGame.gradColorStop = "#ff4747"
+        } else {
+            var comp = game.competition;
+            if (comp === 4) { // dfb pokal
+                mainRectangleGame.gradColorStart = "#105010"
+                mainRectangleGame.gradColorStop = "#509050"
+            }else if (comp === 5) { // badischer pokal
+                mainRectangleGame.gradColorStart = "#103050"
+                mainRectangleGame.gradColorStop = "#507090"
+            } else if (comp === 6) { // TestSpiel
+                mainRectangleGame.gradColorStart = "#101050"
+                mainRectangleGame.gradColorStop = "#905090"
             }
+        }
 
-            if (!gamePlayItem.isGameASeasonTicketGame())
-                return;
-
-            var freeTickets = gamePlayItem.getFreeTickets();
-            if (freeTickets > 0) {
-                freeTicketsItem.visible = true;
-                labelFreeTickets.text = freeTickets;
-            } else {
-                freeTicketsItem.visible = false;
+        labelLineTimeNotFixed.visible = !game.timeFixed
+
+        /* is called again when the values changed, so also hide what is no longer there */
+        var meetingPresent = game.meetingInfo;
+        imageMeetingIsPresent.visible = meetingPresent > 0
+        acceptedMeetingItem.visible = false;
+        interestMeetingItem.visible = false;
+        if (meetingPresent > 0) {
+            if (game.acceptedMeeting > 0) {
+                acceptedMeetingItem.visible = true;
+                labelAcceptedMeeting.text = game.acceptedMeeting;
+            }
+            if (game.interestedMeeting > 0) {
+                interestMeetingItem.visible = true;
+                labelInterestMeeting.text = game.interestedMeeting;
             }
+        }
+
+        if (!game.seasonTicketGame)
+            return;
 
+        if (game.freeTickets > 0) {
+            freeTicketsItem.visible = true;
+            labelFreeTickets.text = game.freeTickets;
+        } else {
+            freeTicketsItem.visible = false;
         }
     }
 
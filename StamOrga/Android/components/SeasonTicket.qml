@@ -142,21 +142,25 @@ Rectangle {
         }
     }
 
-    function showTicketInfo(index) {
-        var seasonTicketItem = globalUserData.getSeasonTicketFromArrayIndex(index)
-
+    function showTicketInfo(seasonTicketItem) {
         if (seasonTicketItem !== null) {
             m_SeasonTicketItem = seasonTicketItem
-            labelTicketItem.text = m_SeasonTicketItem.name
-            labelInfoWhere.text = m_SeasonTicketItem.place;
-            if (m_SeasonTicketItem.discount === 0)
-                labelInfoDiscount.text = "Nein";
-            else
-                labelInfoDiscount.text = "Ja";
-            if (m_SeasonTicketItem.isTicketYourOwn())
-                ticketRectangleItem.border.color = "#EF9A9A"
-
-
+            showTicketValues(seasonTicketItem.name, seasonTicketItem.place,
+                             seasonTicketItem.discount, seasonTicketItem.isTicketYourOwn())
         }
     }
+
+    /* The list of tickets only passes the values of its model, it does not keep the ticket */
+    function showTicketValues(name, place, discount, ownTicket) {
+        labelTicketItem.text = name
+        labelInfoWhere.text = place;
+        if (discount === 0)
+            labelInfoDiscount.text = "Nein";
+        else
+            labelInfoDiscount.text = "Ja";
+        if (ownTicket)
+            ticketRectangleItem.border.color = "#EF9A9A"
+        else
+            ticketRectangleItem.border.color = "grey"
+    }
 }
@@ -17,10 +17,12 @@
 */
 
 #include <QtCore/QDateTime>
+#include <QtCore/QElapsedTimer>
 #include <QtCore/QMetaObject>
 #include <QtGui/QGuiApplication>
 #include <QtQml/QQmlApplicationEngine>
 #include <QtQml/QQmlContext>
+#include <QtQuick/QQuickWindow>
 
 #include <iostream>
 
@@ -37,12 +39,17 @@ GlobalSettings* g_GlobalSettings;
 
 int main(int argc, char* argv[])
 {
+    QElapsedTimer startupTimer;
+    startupTimer.start();
+
     QCoreApplication::setAttribute(Qt::AA_EnableHighDpiScaling);
     QGuiApplication app(argc, argv);
 
 
     // Register our component type with QML.
     qmlRegisterType<UserInterface>("com.watermax.demo", 1, 0, "UserInterface");
+    qmlRegisterType<GamePlayModel>("com.watermax.demo", 1, 0, "GamePlayModel");
+    qmlRegisterType<SeasonTicketModel>("com.watermax.demo", 1, 0, "SeasonTicketModel");
     //    qmlRegisterType<GamePlay>("com.watermax.demo", 1, 0, "MeetingInfo*");
     qRegisterMetaType<GamePlay*>("GamePlay*");
     qRegisterMetaType<SeasonTicketItem*>("SeasonTicketItem*");
@@ -54,6 +61,7 @@ int main(int argc, char* argv[])
     g_GlobalSettings = &globalSettings;
 
     GlobalData globalUserData;
+    globalUserData.setStartupTimer(startupTimer);
     globalSettings.initialize(&globalUserData, &app);
 
 
@@ -63,7 +71,7 @@ int main(int argc, char* argv[])
     engine.rootContext()->setContextProperty("globalSettings", &globalSettings);
     engine.load(QUrl(QLatin1String("qrc:/main.qml")));
 
-    // load settings to update data
+    // load settings to update data, the cached games and tickets follow from a background thread
     globalUserData.loadGlobalSettings();
 
     if (engine.rootObjects().size() == 0) {
@@ -79,6 +87,11 @@ int main(int argc, char* argv[])
 
     QObject* pRootObject
         = engine.rootObjects().first();
+
+    QQuickWindow* pWindow = qobject_cast<QQuickWindow*>(pRootObject);
+    if (pWindow != NULL)
+        QObject::connect(pWindow, &QQuickWindow::frameSwapped, &globalUserData,
+                         &GlobalData::slotStartupFirstFrame, Qt::QueuedConnection);
     if (globalUserData.userName().size() == 0 || globalUserData.passWord().size() == 0)
         QMetaObject::invokeMethod(pRootObject, "openUserLogin", Q_ARG(QVariant, true));
     else
@@ -40,7 +40,6 @@ Flickable {
         if (flickableGames.contentY < -100) {
             showInfoHeader("Lade Spielinfos")
             userIntGames.startListGettingGames()
-            cleanGameLayout();
         }
     }
 
@@ -82,53 +81,47 @@ Flickable {
                 width: parent.width
                 spacing: 10
                 Layout.alignment: Qt.AlignHCenter | Qt.AlignVCenter
-            }
-        }
-    }
-
-    function showListedGames() {
-
-        cleanGameLayout();
 
-        if (globalUserData.getGamePlayLength() > 0) {
-            if (showOnlyPastGames) {
-                for (var i = globalUserData.getGamePlayLength() - 1; i >= 0; i--) {
-                    var gameInfo = globalUserData.getGamePlayFromArrayIndex(i);
-                    if (gameInfo.isGameInPast()) {
-                        var sprite = gameView.createObject(columnLayoutGames)
-                        sprite.showGamesInfo(gameInfo)
-                    }
-                }
-            } else {
-                for (var j = 0; j < globalUserData.getGamePlayLength(); j++) {
-                    var gameInfo2 = globalUserData.getGamePlayFromArrayIndex(j);
-                    if (!gameInfo2.isGameInPast()) {
-                        var sprite2 = gameView.createObject(columnLayoutGames)
-                        sprite2.showGamesInfo(gameInfo2)
+                Repeater {
+                    model: GamePlayModel {
+                        id: gamePlayModel
+                        globalData: globalUserData
+                        onlyPastGames: showOnlyPastGames
                     }
+                    delegate: gameView
                 }
             }
         }
     }
 
-    function cleanGameLayout()
-    {
-        for (var j = columnLayoutGames.children.length; j > 0; j--) {
-            columnLayoutGames.children[j - 1].destroy()
-        }
+    function showListedGames() {
+        /* the model only updates the games which changed */
+        gamePlayModel.refresh()
     }
 
     Component {
         id: gameView
 
         MyComponents.Games {
+            /* only the values of the model, the game object can be deleted by an update meanwhile */
+            property var gameValues: [model.home, model.away, model.score, model.dateLine,
+                                      model.competitionLine, model.competition, model.timeFixed,
+                                      model.inPast, model.running, model.seasonTicketGame,
+                                      model.freeTickets, model.acceptedMeeting, model.interestedMeeting,
+                                      model.meetingInfo]
+            onGameValuesChanged: showGameValues(model)
+            Component.onCompleted: showGameValues(model)
+
             onClickedCurrentGame: {
+                var game = globalUserData.getGamePlay(model.gameIndex)
+                if (game === null)
+                    return;
                 var component = Qt.createComponent("../pages/CurrentGamePage.qml")
                 if (component.status === Component.Ready) {
                     var sprite = stackView.push(component)
                     sprite.userIntCurrentGame = userIntGames
-                    sprite.showAllInfoAboutGame(sender)
-                    if (sender.isGameAHomeGame())
+                    sprite.showAllInfoAboutGame(game)
+                    if (game.isGameAHomeGame())
                         updateHeaderFromMain("Heimspiel", "")
                     else
                         updateHeaderFromMain("Auswärts", "")
@@ -136,15 +129,15 @@ Flickable {
                     console.error("Fehler beim laden von der Spielseite " + component.errorString())
             }
             onPressedAndHoldCurrentGame: {
-                menuSender = sender;
+                menuGameIndex = model.gameIndex;
                 menuItemEditGame.visible = false;
                 menuItemFixedGameTime.visible = false;
                 menuItemNotFixedGameTime.visible = false;
                 if (globalUserData.userIsGameAddingEnabled() || userIntGames.isDebuggingEnabled())
                     menuItemEditGame.visible = true;
 
-                if (globalUserData.userIsGameFixedTimeEnabled() && !sender.isGameInPast()) {
-                    if(sender.timeFixed)
+                if (globalUserData.userIsGameFixedTimeEnabled() && !model.inPast) {
+                    if(model.timeFixed)
                         menuItemNotFixedGameTime.visible = true;
                     else
                         menuItemFixedGameTime.visible = true;
@@ -172,19 +165,22 @@ Flickable {
             height: visible ? implicitHeight : 0
             text: "Spiel editieren"
             onClicked: {
+                var menuGame = globalUserData.getGamePlay(menuGameIndex)
+                if (menuGame === null)
+                    return;
                 var component = Qt.createComponent("../components/ChangeGameDialog.qml");
                 if (component.status === Component.Ready) {
                     var dialog = component.createObject(mainItemGamesMainPage,{popupType: 1});
                     dialog.headerText = "Spiel ändern";
                     dialog.parentHeight = mainItemGamesMainPage.height
                     dialog.parentWidth = mainItemGamesMainPage.width
-                    dialog.homeTeam = menuSender.home;
-                    dialog.awayTeam = menuSender.away;
-                    dialog.score = menuSender.score;
-                    dialog.seasonIndex = menuSender.seasonIndex;
-                    dialog.competitionIndex = menuSender.competitionValue() - 1;
-                    dialog.date = menuSender.timestamp;
-                    dialog.index = menuSender.index;
+                    dialog.homeTeam = menuGame.home;
+                    dialog.awayTeam = menuGame.away;
+                    dialog.score = menuGame.score;
+                    dialog.seasonIndex = menuGame.seasonIndex;
+                    dialog.competitionIndex = menuGame.competitionValue() - 1;
+                    dialog.date = menuGame.timestamp;
+                    dialog.index = menuGame.index;
                     dialog.acceptedDialog.connect(acceptedChangeGameDialog);
                     changeGameDialog = dialog
                     dialog.open();
@@ -196,19 +192,19 @@ Flickable {
             id: menuItemFixedGameTime
             height: visible ? implicitHeight : 0
             text: "Spiel fest terminieren"
-            onClicked: userIntGames.startSetFixedGameTime(menuSender.index, 1)
+            onClicked: userIntGames.startSetFixedGameTime(menuGameIndex, 1)
         }
 
         MenuItem {
             id: menuItemNotFixedGameTime
             height: visible ? implicitHeight : 0
             text: "Spiel nicht fest terminieren"
-            onClicked: userIntGames.startSetFixedGameTime(menuSender.index, 0)
+            onClicked: userIntGames.startSetFixedGameTime(menuGameIndex, 0)
         }
     }
 
     property var changeGameDialog;
-    property var menuSender;
+    property var menuGameIndex;
 
     function acceptedChangeGameDialog()
     {
@@ -207,6 +207,12 @@ Page {
         }
     }
 
+    /* the cached games are loaded after the page was shown */
+    Connections {
+        target: globalUserData
+        onGamePlayListLoaded: showListedGames()
+    }
+
     function notifyUserIntConnectionFinished(result) {}
 
     function notifyUserIntGamesListFinished(result) {
@@ -231,8 +237,6 @@ Page {
         if (result === 1) {
             showLoadingGameInfos("Lade Spielinfos")
             userIntGames.startListGettingGames()
-            gamesListPagePresent.cleanGameLayout();
-            gamesListPagePast.cleanGameLayout();
         }
         else
             toastManager.show(userIntGames.getErrorCodeToString(result), 5000)
@@ -242,8 +246,6 @@ Page {
         if (result === 1) {
             showLoadingGameInfos("Lade Spielinfos")
             userIntGames.startListGettingGames()
-            gamesListPagePresent.cleanGameLayout();
-            gamesListPagePast.cleanGameLayout();
         }
         else
             toastManager.show(userIntGames.getErrorCodeToString(result), 5000)
@@ -25,6 +25,7 @@ import com.watermax.demo 1.0
 Flickable {
    id: flickableLogging
    contentHeight: mainPaneLogging.height
+   property int logPage: 0
 //   width: parent.width
    Pane {
        id: mainPaneLogging
@@ -38,10 +39,38 @@ Flickable {
                model: globalUserData.getCurrentLogFileList()
                anchors.horizontalCenter: parent.horizontalCenter
                onCurrentIndexChanged: {
+                   logPage = 0;
                    txtLogging.text = globalUserData.getCurrentLoggingList(logFilesCombo.currentIndex);
                }
            }
 
+           TextField {
+               id: txtFind
+               implicitWidth: parent.width / 3 * 2
+               Layout.alignment: Qt.AlignHCenter | Qt.AlignVCenter
+               placeholderText: "user=Name game=12 since=18:30"
+               onAccepted: {
+                   if (text.length > 0)
+                       txtLogging.text = globalUserData.findLoggingLines(text);
+                   else
+                       txtLogging.text = globalUserData.getCurrentLoggingList(logFilesCombo.currentIndex);
+                   logPage = 0;
+               }
+           }
+
+           Button {
+               text: "Ältere Einträge"
+               implicitWidth: parent.width / 3 * 2
+               Layout.alignment: Qt.AlignHCenter | Qt.AlignVCenter
+               onClicked: {
+                   var older = globalUserData.getCurrentLoggingList(logFilesCombo.currentIndex, logPage + 1);
+                   if (older.length > 0) {
+                       logPage++;
+                       txtLogging.text = older + txtLogging.text;
+                   }
+               }
+           }
+
            Text {
                id: txtLogging
                wrapMode: Text.WordWrap
@@ -78,6 +107,7 @@ Flickable {
             logFilesCombo.currentIndex = logFilesCombo.count - 1
        else {
            logFilesCombo.visible = false;
+           logPage = 0;
            txtLogging.text = globalUserData.getCurrentLoggingList(0);
        }
    }
@@ -99,6 +99,13 @@ Flickable {
                 spacing: 10
                 Layout.alignment: Qt.AlignHCenter | Qt.AlignVCenter
 
+                Repeater {
+                    model: SeasonTicketModel {
+                        id: seasonTicketModel
+                        globalData: globalUserData
+                    }
+                    delegate: seasonTicketItem
+                }
             }
         }
     }
@@ -132,9 +139,6 @@ Flickable {
         userIntTicket.startListSeasonTickets()
         busyConnectIndicatorTicket.visible = true;
         txtInfoSeasonTicket.text = "Aktualisiere Dauerkarten Liste"
-        for (var j = columnLayoutTickets.children.length; j > 0; j--) {
-            columnLayoutTickets.children[j-1].destroy()
-        }
     }
 
     function notifyUserIntSeasonTicketAdd(result) {
@@ -174,6 +178,11 @@ Flickable {
         }
     }
 
+    Connections {
+        target: globalUserData
+        onSeasonTicketListLoaded: showSeasonTickets()
+    }
+
     function notifyUserIntConnectionFinished(result) {}
 
     function pageOpenedUpdateView() {
@@ -182,17 +191,10 @@ Flickable {
 
     function showSeasonTickets() {
 
-        for (var j = columnLayoutTickets.children.length; j > 0; j--) {
-            columnLayoutTickets.children[j-1].destroy()
-        }
+        /* the model only updates the tickets which changed */
+        seasonTicketModel.refresh()
 
-        if (globalUserData.getSeasonTicketLength() > 0) {
-//            /* Somehow the first element is not visible, so create an not used item */
-//            var test = seasonTicketItem.createObject(columnLayoutTickets)
-            for (var i=0; i<globalUserData.getSeasonTicketLength(); i++) {
-                var sprite = seasonTicketItem.createObject(columnLayoutTickets)
-                sprite.showTicketInfo(i);
-            }
+        if (seasonTicketModel.count > 0) {
             txtInfoSeasonTicket.text = "Letztes Update am " + globalUserData.getSeasonTicketLastLocalUpdateString()
         } else
             txtInfoSeasonTicket.text = "Keine Daten gespeichert\nZiehen zum Aktualisieren"
@@ -202,8 +204,13 @@ Flickable {
     Component {
         id: seasonTicketItem
         MyComponents.SeasonTicket {
+            /* only the values of the model, the ticket object can be deleted by an update meanwhile */
+            property var ticketValues: [model.name, model.place, model.discount, model.ownTicket]
+            onTicketValuesChanged: showTicketValues(model.name, model.place, model.discount, model.ownTicket)
+            Component.onCompleted: showTicketValues(model.name, model.place, model.discount, model.ownTicket)
+
             onClickedSeasonTicket: {
-                seasonTicketClickedMenu.openWithNameAndIndex(sender.name, sender.discount, sender.index)
+                seasonTicketClickedMenu.openWithNameAndIndex(model.name, model.discount, model.ticketIndex)
             }
         }
     }
@@ -25,24 +25,44 @@
 #include "connectionhandling.h"
 
 #define TIMER_DIFF_MSEC 10 * 1000
+#define PUSH_UPDATE_DELAY_MSEC 500
 
 ConnectionHandling::ConnectionHandling(QObject* parent)
     : QObject(parent)
 {
-    this->m_pMainCon             = NULL;
-    this->m_lastSuccessTimeStamp = 0;
+    this->m_pMainCon               = NULL;
+    this->m_lastSuccessTimeStamp   = 0;
+    this->m_conState               = CON_STATE_IDLE;
+    this->m_conStartTimeStamp      = 0;
+    this->m_bDataConReady          = false;
+    this->m_retryGetGamesInfoCount = 0;
+    this->m_retryGetTicketCount    = 0;
+
+    /* The data connection reports when its socket was created in its own thread */
+    connect(&this->m_ctrlDataCon, &BackgroundController::notifyBackgroundWorkerFinished,
+            this, &ConnectionHandling::slDataConReady);
+
+    /* Collect pushes which arrive close together into one update */
+    this->m_bPushUpdateGames     = false;
+    this->m_bPushUpdateGamesInfo = false;
+    this->m_pushUpdateTimer.setSingleShot(true);
+    this->m_pushUpdateTimer.setInterval(PUSH_UPDATE_DELAY_MSEC);
+    connect(&this->m_pushUpdateTimer, &QTimer::timeout, this, &ConnectionHandling::slPushUpdateTimeout);
 }
 
 QString mainConRequestPassWord;
 QString mainConRequestSalt;
 QString mainConRequestRandom;
 
+/*
+ * Signals to the main connection are queued, its thread handles them after DoBackgroundWork
+ * created the socket. So there is no need to wait here for the thread to start.
+ */
 qint32 ConnectionHandling::startMainConnection(QString name, QString passw)
 {
     if (name != this->m_pGlobalData->userName()) {
         this->m_lastSuccessTimeStamp = 0;
         emit this->sSendNewBindingPortRequest();
-        QThread::msleep(10);
     }
 
     if (passw != this->m_pGlobalData->passWord())
@@ -58,14 +78,12 @@ qint32 ConnectionHandling::startMainConnection(QString name, QString passw)
             qInfo().noquote() << "Did not log in again, should already be succesfull";
             return ERROR_CODE_NO_ERROR;
         }
-        this->startDataConnection();
-        QThread::msleep(10);
+        this->m_conStartTimeStamp = now;
         this->sendLoginRequest(passw);
         return ERROR_CODE_SUCCESS;
     }
 
     this->stopDataConnection();
-    QThread::msleep(20);
 
     if (this->m_pMainCon == NULL) {
         this->m_pMainCon = new MainConnection(this->m_pGlobalData);
@@ -73,10 +91,11 @@ qint32 ConnectionHandling::startMainConnection(QString name, QString passw)
         connect(this, &ConnectionHandling::sStartSendMainConRequest, this->m_pMainCon, &MainConnection::slotSendNewMainConRequest);
         connect(this, &ConnectionHandling::sSendNewBindingPortRequest, this->m_pMainCon, &MainConnection::slotNewBindingPortRequest);
         this->m_ctrlMainCon.Start(this->m_pMainCon, false);
-        QThread::msleep(20);
     }
 
-    mainConRequestPassWord = passw;
+    mainConRequestPassWord    = passw;
+    this->m_conState          = CON_STATE_MAIN_CON;
+    this->m_conStartTimeStamp = now;
     emit this->sStartSendMainConRequest(name);
 
     return ERROR_CODE_SUCCESS;
@@ -129,8 +148,8 @@ qint32 ConnectionHandling::startListGettingGamesInfo()
 qint32 ConnectionHandling::startSetFixedGameTime(const quint32 gameIndex, const quint32 fixedTime)
 {
     DataConRequest req(OP_CODE_CMD_REQ::REQ_SET_FIXED_GAME_TIME);
-    req.m_lData.append(QString::number(gameIndex));
-    req.m_lData.append(QString::number(fixedTime));
+    req.appendUInt32(gameIndex);
+    req.appendUInt32(fixedTime);
     this->sendNewRequest(req);
     return ERROR_CODE_SUCCESS;
 }
@@ -138,7 +157,7 @@ qint32 ConnectionHandling::startSetFixedGameTime(const quint32 gameIndex, const
 qint32 ConnectionHandling::startRemoveSeasonTicket(quint32 index)
 {
     DataConRequest req(OP_CODE_CMD_REQ::REQ_REMOVE_TICKET);
-    req.m_lData.append(QString::number(index));
+    req.appendUInt32(index);
     this->sendNewRequest(req);
     return ERROR_CODE_SUCCESS;
 }
@@ -146,10 +165,10 @@ qint32 ConnectionHandling::startRemoveSeasonTicket(quint32 index)
 qint32 ConnectionHandling::startEditSeasonTicket(quint32 index, QString name, QString place, quint32 discount)
 {
     DataConRequest req(OP_CODE_CMD_REQ::REQ_CHANGE_TICKET);
-    req.m_lData.append(QString::number(index));
-    req.m_lData.append(name);
-    req.m_lData.append(place);
-    req.m_lData.append(QString::number(discount));
+    req.appendUInt32(index);
+    req.appendUInt32(discount);
+    req.appendString(name);
+    req.appendString(place);
     this->sendNewRequest(req);
     return ERROR_CODE_SUCCESS;
 }
@@ -157,8 +176,8 @@ qint32 ConnectionHandling::startEditSeasonTicket(quint32 index, QString name, QS
 qint32 ConnectionHandling::startAddSeasonTicket(QString name, quint32 discount)
 {
     DataConRequest req(OP_CODE_CMD_REQ::REQ_ADD_TICKET);
-    req.m_lData.append(QString::number(discount));
-    req.m_lData.append(name);
+    req.appendUInt32(discount);
+    req.appendSizedString(name);
     this->sendNewRequest(req);
     return ERROR_CODE_SUCCESS;
 }
@@ -173,10 +192,10 @@ qint32 ConnectionHandling::startListSeasonTickets()
 qint32 ConnectionHandling::startChangeSeasonTicketState(quint32 tickedIndex, quint32 gameIndex, quint32 state, QString name)
 {
     DataConRequest req(OP_CODE_CMD_REQ::REQ_STATE_CHANGE_SEASON_TICKET);
-    req.m_lData.append(QString::number(tickedIndex));
-    req.m_lData.append(QString::number(gameIndex));
-    req.m_lData.append(QString::number(state));
-    req.m_lData.append(name);
+    req.appendUInt32(tickedIndex);
+    req.appendUInt32(gameIndex);
+    req.appendUInt32(state);
+    req.appendSizedString(name);
     this->sendNewRequest(req);
     return ERROR_CODE_SUCCESS;
 }
@@ -189,7 +208,7 @@ qint32 ConnectionHandling::startListAvailableTicket(quint32 gameIndex)
     //        return this->startListSeasonTickets();
 
     DataConRequest req(OP_CODE_CMD_REQ::REQ_GET_AVAILABLE_TICKETS);
-    req.m_lData.append(QString::number(gameIndex));
+    req.m_index = gameIndex;
     this->sendNewRequest(req);
     return ERROR_CODE_SUCCESS;
 }
@@ -214,7 +233,7 @@ qint32 ConnectionHandling::startChangeGame(const quint32 index, const quint32 sI
 
     QString        val = QString("%1;%2;%3;%4;%5;%6;%7").arg(home, away, date, score).arg(index).arg(sIndex).arg(compIndex);
     DataConRequest req(OP_CODE_CMD_REQ::REQ_CHANGE_GAME);
-    req.m_lData.append(val);
+    req.appendString(val);
     this->sendNewRequest(req);
     return ERROR_CODE_SUCCESS;
 }
@@ -225,10 +244,10 @@ qint32 ConnectionHandling::startSaveMeetingInfo(const quint32 gameIndex, const Q
 
     if (pInfo->when() != when || pInfo->where() != where || pInfo->info() != info) {
         DataConRequest req(OP_CODE_CMD_REQ::REQ_CHANGE_MEETING_INFO);
-        req.m_lData.append(QString::number(gameIndex));
-        req.m_lData.append(when);
-        req.m_lData.append(where);
-        req.m_lData.append(info);
+        req.appendUInt32(gameIndex);
+        req.appendString(when);
+        req.appendString(where);
+        req.appendString(info);
         this->sendNewRequest(req);
 
         return ERROR_CODE_SUCCESS;
@@ -239,7 +258,7 @@ qint32 ConnectionHandling::startSaveMeetingInfo(const quint32 gameIndex, const Q
 qint32 ConnectionHandling::startLoadMeetingInfo(const quint32 gameIndex)
 {
     DataConRequest req(OP_CODE_CMD_REQ::REQ_GET_MEETING_INFO);
-    req.m_lData.append(QString::number(gameIndex));
+    req.appendUInt32(gameIndex);
     this->sendNewRequest(req);
 
     return ERROR_CODE_SUCCESS;
@@ -248,15 +267,49 @@ qint32 ConnectionHandling::startLoadMeetingInfo(const quint32 gameIndex)
 qint32 ConnectionHandling::startAcceptMeetingInfo(const quint32 gameIndex, const quint32 accept, const QString name, const quint32 acceptIndex)
 {
     DataConRequest req(OP_CODE_CMD_REQ::REQ_ACCEPT_MEETING);
-    req.m_lData.append(QString::number(gameIndex));
-    req.m_lData.append(QString::number(accept));
-    req.m_lData.append(QString::number(acceptIndex));
-    req.m_lData.append(name);
+    req.appendUInt32(gameIndex);
+    req.appendUInt32(accept);
+    req.appendUInt32(acceptIndex);
+    req.appendString(name);
+    req.appendUInt32(0); /* server expects at least 16 bytes */
+    this->sendNewRequest(req);
+
+    return ERROR_CODE_SUCCESS;
+}
+
+qint32 ConnectionHandling::startSubscribePush()
+{
+    DataConRequest req(OP_CODE_CMD_REQ::REQ_SUBSCRIBE_PUSH);
     this->sendNewRequest(req);
 
     return ERROR_CODE_SUCCESS;
 }
 
+void ConnectionHandling::slDataConPushChange(quint32 type, quint32 gameIndex)
+{
+    qInfo().noquote() << QString("Received push %1 for game %2").arg(type).arg(gameIndex);
+
+    if (type == PUSH_GAME_CHANGED)
+        this->m_bPushUpdateGames = true;
+    else
+        this->m_bPushUpdateGamesInfo = true;
+
+    if (!this->m_pushUpdateTimer.isActive())
+        this->m_pushUpdateTimer.start();
+}
+
+void ConnectionHandling::slPushUpdateTimeout()
+{
+    /* games list answer starts loading the games info in UserInterface */
+    if (this->m_bPushUpdateGames)
+        this->startListGettingGames();
+    else if (this->m_bPushUpdateGamesInfo)
+        this->startListGettingGamesInfo();
+
+    this->m_bPushUpdateGames     = false;
+    this->m_bPushUpdateGamesInfo = false;
+}
+
 /*
  * Answer function after connection with username
  */
@@ -265,8 +318,6 @@ void ConnectionHandling::slMainConReqFin(qint32 result, const QString msg, const
     if (result > ERROR_CODE_NO_ERROR) {
         qInfo().noquote() << QString("Trying login request with port %1").arg(result);
         this->m_pGlobalData->setConDataPort((quint16)result);
-        this->startDataConnection();
-        QThread::msleep(20);
         mainConRequestSalt   = salt;
         mainConRequestRandom = random;
         this->sendLoginRequest(mainConRequestPassWord);
@@ -276,14 +327,10 @@ void ConnectionHandling::slMainConReqFin(qint32 result, const QString msg, const
         this->m_ctrlMainCon.Stop();
         this->m_pMainCon = NULL;
         this->stopDataConnection();
+        this->m_conState = CON_STATE_IDLE;
         emit this->sNotifyConnectionFinished(result);
 
-        while (this->m_lErrorMainCon.size() > 0) {
-            DataConRequest request = this->m_lErrorMainCon.last();
-            request.m_result       = result;
-            this->slDataConLastRequestFinished(request);
-            this->m_lErrorMainCon.removeLast();
-        }
+        this->finishErrorMainConRequests(result);
     }
 }
 
@@ -299,60 +346,123 @@ void ConnectionHandling::sendLoginRequest(QString password)
     req.m_lData.append(password);
     req.m_lData.append(mainConRequestSalt);
 
-    emit this->sStartSendNewRequest(req);
+    this->m_conState = CON_STATE_LOGIN;
+    this->sendDataConRequest(req);
 }
 
 void ConnectionHandling::sendNewRequest(DataConRequest request)
 {
+    /* A connect is already running, the request is send when it finished */
+    if (this->m_conState == CON_STATE_MAIN_CON || this->m_conState == CON_STATE_LOGIN) {
+        this->addErrorMainConRequest(request);
+        return;
+    }
+
     qint64 now = QDateTime::currentMSecsSinceEpoch();
     if ((now - this->m_lastSuccessTimeStamp) < (CON_RESET_TIMEOUT_MSEC - TIMER_DIFF_MSEC)) {
         this->startDataConnection();
 
         if ((now - this->m_lastSuccessTimeStamp) < (CON_LOGIN_TIMEOUT_MSEC - TIMER_DIFF_MSEC)) {
-            emit this->sStartSendNewRequest(request);
+            this->sendDataConRequest(request);
             return;
-        } else {
-            this->m_lErrorMainCon.prepend(request);
-            if (this->m_lErrorMainCon.size() == 1) {
-                qInfo().noquote() << QString("Trying to reconnect from ConnectionHandling");
-                this->m_pGlobalData->setbIsConnected(false);
-                this->sendLoginRequest(this->m_pGlobalData->passWord());
-            }
         }
+        this->addErrorMainConRequest(request);
+        qInfo().noquote() << QString("Trying to reconnect from ConnectionHandling");
+        this->m_pGlobalData->setbIsConnected(false);
+        this->m_conStartTimeStamp = now;
+        this->sendLoginRequest(this->m_pGlobalData->passWord());
     } else {
-        this->m_lErrorMainCon.prepend(request);
-        if (this->m_lErrorMainCon.size() == 1) {
-            qInfo().noquote() << QString("Trying to restart connection from ConnectionHandling");
-            this->startMainConnection(this->m_pGlobalData->userName(), this->m_pGlobalData->passWord());
+        this->addErrorMainConRequest(request);
+        qInfo().noquote() << QString("Trying to restart connection from ConnectionHandling");
+        this->startMainConnection(this->m_pGlobalData->userName(), this->m_pGlobalData->passWord());
+    }
+}
+
+/*
+ * The data connection creates its socket in its own thread, requests are hold back until it
+ * reported to be ready in slDataConReady
+ */
+void ConnectionHandling::sendDataConRequest(DataConRequest request)
+{
+    if (this->m_bDataConReady)
+        emit this->sStartSendNewRequest(request);
+    else
+        this->m_lDataConNotReady.append(request);
+}
+
+void ConnectionHandling::slDataConReady(const int& result)
+{
+    this->m_bDataConReady = (result == 0 && this->isDataConnectionActive());
+    if (!this->m_bDataConReady)
+        qWarning().noquote() << QString("Data connection could not be started: %1").arg(result);
+
+    while (this->m_lDataConNotReady.size() > 0) {
+        DataConRequest request = this->m_lDataConNotReady.takeFirst();
+        if (this->m_bDataConReady) {
+            emit this->sStartSendNewRequest(request);
+        } else {
+            request.m_result = ERROR_CODE_ERR_SEND;
+            this->slDataConLastRequestFinished(request);
         }
     }
 }
 
+/* Requests waiting for the connection which are equal to an already waiting one are only send once */
+void ConnectionHandling::addErrorMainConRequest(DataConRequest request)
+{
+    foreach (const DataConRequest& waiting, this->m_lErrorMainCon) {
+        if (waiting.m_request == request.m_request && waiting.m_index == request.m_index
+            && waiting.m_payload == request.m_payload && waiting.m_lData == request.m_lData)
+            return;
+    }
+    this->m_lErrorMainCon.prepend(request);
+}
+
+void ConnectionHandling::finishErrorMainConRequests(qint32 result)
+{
+    while (this->m_lErrorMainCon.size() > 0) {
+        DataConRequest request = this->m_lErrorMainCon.last();
+        request.m_result       = result;
+        this->slDataConLastRequestFinished(request);
+        this->m_lErrorMainCon.removeLast();
+    }
+}
+
 
 void ConnectionHandling::slDataConLastRequestFinished(DataConRequest request)
 {
     this->checkTimeoutResult(request.m_result);
 
+    if (this->m_conStartTimeStamp > 0 && request.m_result == ERROR_CODE_SUCCESS) {
+        qint64 diff = QDateTime::currentMSecsSinceEpoch() - this->m_conStartTimeStamp;
+        if (request.m_request == OP_CODE_CMD_REQ::REQ_LOGIN_USER) {
+            qInfo().noquote() << QString("Connected after %1ms").arg(diff);
+        } else {
+            qInfo().noquote() << QString("First response 0x%1 after %2ms")
+                                     .arg(QString::number(request.m_request, 16))
+                                     .arg(diff);
+            this->m_conStartTimeStamp = 0;
+        }
+    }
+
     switch (request.m_request) {
     case OP_CODE_CMD_REQ::REQ_LOGIN_USER:
         if (request.m_result == ERROR_CODE_SUCCESS) {
-            this->startGettingVersionInfo();
-            this->startGettingUserProps();
-            QThread::msleep(10);
+            this->m_conState = CON_STATE_CONNECTED;
             this->m_pGlobalData->setbIsConnected(true);
             this->checkTimeoutResult(request.m_result); // call again to set last successfull timer
+            this->startGettingVersionInfo();
+            this->startGettingUserProps();
+            this->startSubscribePush();
             while (this->m_lErrorMainCon.size() > 0) {
                 this->sendNewRequest(this->m_lErrorMainCon.last());
                 this->m_lErrorMainCon.removeLast();
             }
         } else {
             qWarning().noquote() << QString("Error Login: %1").arg(getErrorCodeString(request.m_result));
-            while (this->m_lErrorMainCon.size() > 0) {
-                DataConRequest newReq = this->m_lErrorMainCon.last();
-                newReq.m_result       = request.m_result;
-                this->slDataConLastRequestFinished(newReq);
-                this->m_lErrorMainCon.removeLast();
-            }
+            this->m_conState          = CON_STATE_IDLE;
+            this->m_conStartTimeStamp = 0;
+            this->finishErrorMainConRequests(request.m_result);
         }
 
         emit this->sNotifyConnectionFinished(request.m_result);
@@ -380,41 +490,42 @@ void ConnectionHandling::slDataConLastRequestFinished(DataConRequest request)
         emit this->sNotifyCommandFinished(request.m_request, request.m_result);
         break;
 
-    case OP_CODE_CMD_REQ::REQ_GET_GAMES_INFO_LIST: {
-
-        static quint32 retryGetGamesInfoCount = 0;
+    case OP_CODE_CMD_REQ::REQ_GET_GAMES_INFO_LIST:
         if (request.m_result == ERROR_CODE_UPDATE_LIST) {
-            if (retryGetGamesInfoCount < 3) {
+            if (this->m_retryGetGamesInfoCount < 3) {
                 this->startListGettingGames();
-                retryGetGamesInfoCount++;
+                this->m_retryGetGamesInfoCount++;
                 return;
             }
         }
         emit this->sNotifyCommandFinished(request.m_request, request.m_result);
-        retryGetGamesInfoCount = 0;
+        this->m_retryGetGamesInfoCount = 0;
         break;
-    }
 
-    case OP_CODE_CMD_REQ::REQ_GET_AVAILABLE_TICKETS: {
-
-        static quint32 retryGetTicketCount = 0;
+    case OP_CODE_CMD_REQ::REQ_GET_AVAILABLE_TICKETS:
         if (request.m_result == ERROR_CODE_UPDATE_LIST) {
-            if (retryGetTicketCount < 3) {
+            if (this->m_retryGetTicketCount < 3) {
                 this->startListSeasonTickets();
-                retryGetTicketCount++;
+                this->m_retryGetTicketCount++;
                 return;
             }
         }
         emit this->sNotifyCommandFinished(request.m_request, request.m_result);
-        retryGetTicketCount = 0;
+        this->m_retryGetTicketCount = 0;
         break;
-    }
+
     case OP_CODE_CMD_REQ::REQ_GET_MEETING_INFO:
         emit this->sNotifyCommandFinished(request.m_request, request.m_result);
         if (request.m_result == ERROR_CODE_NOT_FOUND)
             return;
         break;
 
+    case OP_CODE_CMD_REQ::REQ_SUBSCRIBE_PUSH:
+        /* without pushes the app keeps polling when it gets active */
+        if (request.m_result != ERROR_CODE_SUCCESS)
+            this->m_pGlobalData->setPushActive(false);
+        break;
+
 
     default:
         emit this->sNotifyCommandFinished(request.m_request, request.m_result);
@@ -431,6 +542,7 @@ void ConnectionHandling::checkTimeoutResult(qint32 result)
 {
     if (result == ERROR_CODE_TIMEOUT) {
         this->stopDataConnection();
+        this->m_conState             = CON_STATE_IDLE;
         this->m_lastSuccessTimeStamp = 0;
         emit this->sSendNewBindingPortRequest();
     } else if (this->m_pGlobalData->bIsConnected())
@@ -444,12 +556,16 @@ void ConnectionHandling::startDataConnection()
         return;
     }
 
-    this->m_pDataCon = new DataConnection(this->m_pGlobalData);
+    this->m_bDataConReady = false;
+    this->m_pDataCon      = new DataConnection(this->m_pGlobalData);
+    this->m_pDataCon->setRandomLoginValue(mainConRequestRandom);
 
     connect(this, &ConnectionHandling::sStartSendNewRequest,
             this->m_pDataCon, &DataConnection::startSendNewRequest);
     connect(this->m_pDataCon, &DataConnection::notifyLastRequestFinished,
             this, &ConnectionHandling::slDataConLastRequestFinished);
+    connect(this->m_pDataCon, &DataConnection::notifyPushChange,
+            this, &ConnectionHandling::slDataConPushChange);
 
     this->m_ctrlDataCon.Start(this->m_pDataCon, false);
 }
@@ -457,6 +573,15 @@ void ConnectionHandling::startDataConnection()
 void ConnectionHandling::stopDataConnection()
 {
     this->m_pGlobalData->setbIsConnected(false);
+    this->m_pGlobalData->setPushActive(false);
+
+    /* A new login is send with the next connect, the other requests wait for it */
+    this->m_bDataConReady = false;
+    while (this->m_lDataConNotReady.size() > 0) {
+        DataConRequest request = this->m_lDataConNotReady.takeFirst();
+        if (request.m_request != OP_CODE_CMD_REQ::REQ_LOGIN_USER)
+            this->addErrorMainConRequest(request);
+    }
 
     if (!this->isDataConnectionActive())
         return;
@@ -465,6 +590,8 @@ void ConnectionHandling::stopDataConnection()
                this->m_pDataCon, &DataConnection::startSendNewRequest);
     disconnect(this->m_pDataCon, &DataConnection::notifyLastRequestFinished,
                this, &ConnectionHandling::slDataConLastRequestFinished);
+    disconnect(this->m_pDataCon, &DataConnection::notifyPushChange,
+               this, &ConnectionHandling::slDataConPushChange);
 
     this->m_ctrlDataCon.Stop();
 }
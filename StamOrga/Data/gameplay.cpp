@@ -103,6 +103,45 @@ void GamePlay::setEnableAddGame(bool enable)
     this->m_bIsUserGameAddingEnabled = enable;
 }
 
+/* Only sets the values which differ, returns true when there was one */
+bool GamePlay::setValues(const GamePlayValues& values)
+{
+    bool bChanged = false;
+    if (this->m_index != values.m_index) {
+        this->setIndex(values.m_index);
+        bChanged = true;
+    }
+    if (this->m_home != values.m_home) {
+        this->setHome(values.m_home);
+        bChanged = true;
+    }
+    if (this->m_away != values.m_away) {
+        this->setAway(values.m_away);
+        bChanged = true;
+    }
+    if (this->m_score != values.m_score) {
+        this->setScore(values.m_score);
+        bChanged = true;
+    }
+    if (this->m_timestamp != values.m_timestamp) {
+        this->setTimeStamp(values.m_timestamp);
+        bChanged = true;
+    }
+    if (this->m_seasonIndex != values.m_seasonIndex) {
+        this->setSeasonIndex(values.m_seasonIndex);
+        bChanged = true;
+    }
+    if (this->m_comp != values.m_competition) {
+        this->setCompetition(values.m_competition);
+        bChanged = true;
+    }
+    if (this->m_timeFixed != values.m_timeFixed) {
+        this->setTimeFixed(values.m_timeFixed);
+        bChanged = true;
+    }
+    return bChanged;
+}
+
 bool GamePlay::compareTimeStampFunction(GamePlay* p1, GamePlay* p2)
 {
     if (p1->m_timestamp > p2->m_timestamp)
@@ -25,6 +25,18 @@
 
 #include "../../Common/General/globalfunctions.h"
 
+/* Plain values of a game, so received games can be compared before an object is created */
+struct GamePlayValues {
+    quint32          m_index;
+    quint8           m_seasonIndex;
+    CompetitionIndex m_competition;
+    bool             m_timeFixed;
+    qint64           m_timestamp;
+    QString          m_home;
+    QString          m_away;
+    QString          m_score;
+};
+
 class GamePlay : public QObject
 {
     Q_OBJECT
@@ -101,8 +113,8 @@ public:
         }
     }
 
-    quint8 index() { return this->m_index; }
-    void setIndex(const quint8 index)
+    quint32 index() { return this->m_index; }
+    void setIndex(const quint32 index)
     {
         if (this->m_index != index) {
             this->m_index = index;
@@ -182,6 +194,8 @@ public:
 
     void setEnableAddGame(bool enable);
 
+    bool setValues(const GamePlayValues& values);
+
     static bool compareTimeStampFunction(GamePlay* p1, GamePlay* p2);
 
 signals:
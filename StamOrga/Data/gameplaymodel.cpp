@@ -0,0 +1,258 @@
+/*
+*	This file is part of StamOrga
+*   Copyright (C) 2017 Markus Schneider
+*
+*	This program is free software; you can redistribute it and/or modify
+*   it under the terms of the GNU General Public License as published by
+*   the Free Software Foundation; either version 3 of the License, or
+*   (at your option) any later version.
+*
+*	StamOrga is distributed in the hope that it will be useful,
+*    but WITHOUT ANY WARRANTY; without even the implied warranty of
+*    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+*    GNU General Public License for more details.
+
+*    You should have received a copy of the GNU General Public License
+*    along with StamOrga.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include <QtCore/QSet>
+
+#include <algorithm>
+
+#include "gameplaymodel.h"
+#include "globaldata.h"
+
+GamePlayModel::GamePlayModel(QObject* parent)
+    : QAbstractListModel(parent)
+{
+    this->m_pGlobalData    = NULL;
+    this->m_bOnlyPastGames = false;
+}
+
+QObject* GamePlayModel::globalData()
+{
+    return this->m_pGlobalData;
+}
+
+void GamePlayModel::setGlobalData(QObject* globalData)
+{
+    GlobalData* pGlobalData = qobject_cast<GlobalData*>(globalData);
+    if (this->m_pGlobalData != pGlobalData) {
+        if (this->m_pGlobalData != NULL)
+            disconnect(this->m_pGlobalData, &GlobalData::gamePlayListLoaded, this, &GamePlayModel::refresh);
+        this->m_pGlobalData = pGlobalData;
+        /* the cached games are loaded in the background at startup */
+        if (this->m_pGlobalData != NULL)
+            connect(this->m_pGlobalData, &GlobalData::gamePlayListLoaded, this, &GamePlayModel::refresh);
+        emit this->globalDataChanged();
+        this->refresh();
+    }
+}
+
+void GamePlayModel::setOnlyPastGames(const bool onlyPast)
+{
+    if (this->m_bOnlyPastGames != onlyPast) {
+        this->m_bOnlyPastGames = onlyPast;
+        emit this->onlyPastGamesChanged();
+
+        /* the order is the other way round, so start again */
+        this->beginResetModel();
+        this->m_rows.clear();
+        this->endResetModel();
+        this->refresh();
+    }
+}
+
+int GamePlayModel::rowCount(const QModelIndex& parent) const
+{
+    if (parent.isValid())
+        return 0;
+    return this->m_rows.size();
+}
+
+QVariant GamePlayModel::data(const QModelIndex& index, int role) const
+{
+    if (!index.isValid() || index.row() >= this->m_rows.size())
+        return QVariant();
+
+    const GamePlayRow& row = this->m_rows.at(index.row());
+    switch (role) {
+    case GameIndexRole:
+        return row.m_index;
+    case HomeRole:
+        return row.m_home;
+    case AwayRole:
+        return row.m_away;
+    case ScoreRole:
+        return row.m_score;
+    case TimestampRole:
+        return row.m_timestamp;
+    case DateLineRole:
+        return row.m_dateLine;
+    case CompetitionLineRole:
+        return row.m_competitionLine;
+    case CompetitionRole:
+        return row.m_competition;
+    case SeasonIndexRole:
+        return row.m_seasonIndex;
+    case TimeFixedRole:
+        return row.m_timeFixed;
+    case InPastRole:
+        return row.m_bInPast;
+    case RunningRole:
+        return row.m_bRunning;
+    case SeasonTicketGameRole:
+        return row.m_bSeasonTicketGame;
+    case FreeTicketsRole:
+        return row.m_freeTickets;
+    case AcceptedMeetingRole:
+        return row.m_acceptedMeeting;
+    case InterestedMeetingRole:
+        return row.m_interestedMeeting;
+    case DeclinedMeetingRole:
+        return row.m_declinedMeeting;
+    case MeetingInfoRole:
+        return row.m_meetingInfo;
+    default:
+        return QVariant();
+    }
+}
+
+QHash<int, QByteArray> GamePlayModel::roleNames() const
+{
+    QHash<int, QByteArray> roles;
+    roles[GameIndexRole]         = "gameIndex";
+    roles[HomeRole]              = "home";
+    roles[AwayRole]              = "away";
+    roles[ScoreRole]             = "score";
+    roles[TimestampRole]         = "timestamp";
+    roles[DateLineRole]          = "dateLine";
+    roles[CompetitionLineRole]   = "competitionLine";
+    roles[CompetitionRole]       = "competition";
+    roles[SeasonIndexRole]       = "seasonIndex";
+    roles[TimeFixedRole]         = "timeFixed";
+    roles[InPastRole]            = "inPast";
+    roles[RunningRole]           = "running";
+    roles[SeasonTicketGameRole]  = "seasonTicketGame";
+    roles[FreeTicketsRole]       = "freeTickets";
+    roles[AcceptedMeetingRole]   = "acceptedMeeting";
+    roles[InterestedMeetingRole] = "interestedMeeting";
+    roles[DeclinedMeetingRole]   = "declinedMeeting";
+    roles[MeetingInfoRole]       = "meetingInfo";
+    return roles;
+}
+
+/*
+ * Takes the current games from the global data and only reports the differences to the view,
+ * so delegates of games which did not change are not touched
+ */
+void GamePlayModel::refresh()
+{
+    if (this->m_pGlobalData == NULL)
+        return;
+
+    QVector<GamePlayRow> allRows;
+    this->m_pGlobalData->getGamePlayRows(allRows);
+
+    QVector<GamePlayRow> rows;
+    rows.reserve(allRows.size());
+    foreach (const GamePlayRow& row, allRows) {
+        if (row.m_bInPast == this->m_bOnlyPastGames)
+            rows.append(row);
+    }
+    if (this->m_bOnlyPastGames)
+        std::reverse(rows.begin(), rows.end());
+
+    int oldCount = this->m_rows.size();
+
+    QSet<quint32> newIndexes;
+    foreach (const GamePlayRow& row, rows)
+        newIndexes.insert(row.m_index);
+
+    for (int i = this->m_rows.size() - 1; i >= 0; i--) {
+        if (!newIndexes.contains(this->m_rows[i].m_index)) {
+            this->beginRemoveRows(QModelIndex(), i, i);
+            this->m_rows.remove(i);
+            this->endRemoveRows();
+        }
+    }
+
+    /* when the remaining games changed their order, start again */
+    QSet<quint32> oldIndexes;
+    foreach (const GamePlayRow& row, this->m_rows)
+        oldIndexes.insert(row.m_index);
+    int  oldPos     = 0;
+    bool bSameOrder = true;
+    foreach (const GamePlayRow& row, rows) {
+        if (!oldIndexes.contains(row.m_index))
+            continue;
+        if (this->m_rows[oldPos++].m_index != row.m_index) {
+            bSameOrder = false;
+            break;
+        }
+    }
+
+    if (!bSameOrder) {
+        this->beginResetModel();
+        this->m_rows = rows;
+        this->endResetModel();
+    } else {
+        for (int i = 0; i < rows.size(); i++) {
+            if (i < this->m_rows.size() && this->m_rows[i].m_index == rows[i].m_index) {
+                QVector<int> roles = this->getChangedRoles(this->m_rows[i], rows[i]);
+                if (!roles.isEmpty()) {
+                    this->m_rows[i] = rows[i];
+                    emit this->dataChanged(this->index(i), this->index(i), roles);
+                }
+            } else {
+                this->beginInsertRows(QModelIndex(), i, i);
+                this->m_rows.insert(i, rows[i]);
+                this->endInsertRows();
+            }
+        }
+    }
+
+    if (oldCount != this->m_rows.size())
+        emit this->countChanged();
+}
+
+QVector<int> GamePlayModel::getChangedRoles(const GamePlayRow& oldRow, const GamePlayRow& newRow)
+{
+    QVector<int> roles;
+    if (oldRow.m_home != newRow.m_home)
+        roles.append(HomeRole);
+    if (oldRow.m_away != newRow.m_away)
+        roles.append(AwayRole);
+    if (oldRow.m_score != newRow.m_score)
+        roles.append(ScoreRole);
+    if (oldRow.m_timestamp != newRow.m_timestamp)
+        roles.append(TimestampRole);
+    if (oldRow.m_dateLine != newRow.m_dateLine)
+        roles.append(DateLineRole);
+    if (oldRow.m_competitionLine != newRow.m_competitionLine)
+        roles.append(CompetitionLineRole);
+    if (oldRow.m_competition != newRow.m_competition)
+        roles.append(CompetitionRole);
+    if (oldRow.m_seasonIndex != newRow.m_seasonIndex)
+        roles.append(SeasonIndexRole);
+    if (oldRow.m_timeFixed != newRow.m_timeFixed)
+        roles.append(TimeFixedRole);
+    if (oldRow.m_bInPast != newRow.m_bInPast)
+        roles.append(InPastRole);
+    if (oldRow.m_bRunning != newRow.m_bRunning)
+        roles.append(RunningRole);
+    if (oldRow.m_bSeasonTicketGame != newRow.m_bSeasonTicketGame)
+        roles.append(SeasonTicketGameRole);
+    if (oldRow.m_freeTickets != newRow.m_freeTickets)
+        roles.append(FreeTicketsRole);
+    if (oldRow.m_acceptedMeeting != newRow.m_acceptedMeeting)
+        roles.append(AcceptedMeetingRole);
+    if (oldRow.m_interestedMeeting != newRow.m_interestedMeeting)
+        roles.append(InterestedMeetingRole);
+    if (oldRow.m_declinedMeeting != newRow.m_declinedMeeting)
+        roles.append(DeclinedMeetingRole);
+    if (oldRow.m_meetingInfo != newRow.m_meetingInfo)
+        roles.append(MeetingInfoRole);
+    return roles;
+}
@@ -0,0 +1,109 @@
+/*
+*	This file is part of StamOrga
+*   Copyright (C) 2017 Markus Schneider
+*
+*	This program is free software; you can redistribute it and/or modify
+*   it under the terms of the GNU General Public License as published by
+*   the Free Software Foundation; either version 3 of the License, or
+*   (at your option) any later version.
+*
+*	StamOrga is distributed in the hope that it will be useful,
+*    but WITHOUT ANY WARRANTY; without even the implied warranty of
+*    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+*    GNU General Public License for more details.
+
+*    You should have received a copy of the GNU General Public License
+*    along with StamOrga.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#ifndef GAMEPLAYMODEL_H
+#define GAMEPLAYMODEL_H
+
+#include <QtCore/QAbstractListModel>
+#include <QtCore/QVector>
+
+class GlobalData;
+
+/*
+ * Copy of the values of one game, taken at once for all games. The view only gets these
+ * values, the game object is looked up by its index when it is needed.
+ */
+struct GamePlayRow {
+    quint32 m_index;
+    QString m_home;
+    QString m_away;
+    QString m_score;
+    qint64  m_timestamp;
+    QString m_dateLine;
+    QString m_competitionLine;
+    quint8  m_competition;
+    quint8  m_seasonIndex;
+    bool    m_timeFixed;
+    bool    m_bInPast;
+    bool    m_bRunning;
+    bool    m_bSeasonTicketGame;
+    quint16 m_freeTickets;
+    quint16 m_acceptedMeeting;
+    quint16 m_interestedMeeting;
+    quint16 m_declinedMeeting;
+    quint16 m_meetingInfo;
+};
+
+class GamePlayModel : public QAbstractListModel
+{
+    Q_OBJECT
+    Q_PROPERTY(QObject* globalData READ globalData WRITE setGlobalData NOTIFY globalDataChanged)
+    Q_PROPERTY(bool onlyPastGames READ onlyPastGames WRITE setOnlyPastGames NOTIFY onlyPastGamesChanged)
+    Q_PROPERTY(int count READ count NOTIFY countChanged)
+public:
+    enum GamePlayRoles {
+        GameIndexRole = Qt::UserRole + 1,
+        HomeRole,
+        AwayRole,
+        ScoreRole,
+        TimestampRole,
+        DateLineRole,
+        CompetitionLineRole,
+        CompetitionRole,
+        SeasonIndexRole,
+        TimeFixedRole,
+        InPastRole,
+        RunningRole,
+        SeasonTicketGameRole,
+        FreeTicketsRole,
+        AcceptedMeetingRole,
+        InterestedMeetingRole,
+        DeclinedMeetingRole,
+        MeetingInfoRole
+    };
+
+    explicit GamePlayModel(QObject* parent = 0);
+
+    QObject* globalData();
+    void setGlobalData(QObject* globalData);
+
+    bool onlyPastGames() { return this->m_bOnlyPastGames; }
+    void setOnlyPastGames(const bool onlyPast);
+
+    int count() { return this->m_rows.size(); }
+
+    int rowCount(const QModelIndex& parent = QModelIndex()) const override;
+    QVariant data(const QModelIndex& index, int role = Qt::DisplayRole) const override;
+    QHash<int, QByteArray> roleNames() const override;
+
+    Q_INVOKABLE void refresh();
+
+signals:
+    void globalDataChanged();
+    void onlyPastGamesChanged();
+    void countChanged();
+
+private:
+    QVector<int> getChangedRoles(const GamePlayRow& oldRow, const GamePlayRow& newRow);
+
+    GlobalData*          m_pGlobalData;
+    bool                 m_bOnlyPastGames;
+    QVector<GamePlayRow> m_rows;
+};
+
+#endif // GAMEPLAYMODEL_H
@@ -16,6 +16,7 @@
 *    along with StamOrga.  If not, see <http://www.gnu.org/licenses/>.
 */
 
+#include <QtCore/QDataStream>
 #include <QtCore/QDebug>
 #include <QtCore/QStandardPaths>
 #include <QtGui/QClipboard>
@@ -23,6 +24,7 @@
 #include <QtNetwork/QNetworkConfigurationManager>
 #include <QtQml/QQmlEngine>
 
+#include "../../Common/General/globaltiming.h"
 #include "globaldata.h"
 #include "globalsettings.h"
 
@@ -44,6 +46,51 @@
 #define TICKET_DISCOUNT "discount"
 #define TICKET_USER_INDEX "userIndex"
 
+#define CACHE_GAMES_FILE "/Cache/Games.bin"
+#define CACHE_TICKETS_FILE "/Cache/SeasonTickets.bin"
+
+static QByteArray serializeGamePlay(GamePlay* play)
+{
+    QByteArray  data;
+    QDataStream stream(&data, QIODevice::WriteOnly);
+    stream.setVersion(QDataStream::Qt_5_6);
+    stream << play->home() << play->away() << play->timestamp64Bit() << play->seasonIndex()
+           << play->score() << quint8(play->competitionValue()) << play->timeFixed();
+    return data;
+}
+
+static bool deserializeGamePlay(quint32 index, const QByteArray& data, GamePlayValues& values)
+{
+    QDataStream stream(data);
+    stream.setVersion(QDataStream::Qt_5_6);
+
+    quint8 competition;
+    stream >> values.m_home >> values.m_away >> values.m_timestamp >> values.m_seasonIndex
+        >> values.m_score >> competition >> values.m_timeFixed;
+    values.m_index       = index;
+    values.m_competition = CompetitionIndex(competition);
+    return stream.status() == QDataStream::Ok;
+}
+
+static QByteArray serializeSeasonTicket(SeasonTicketItem* ticket)
+{
+    QByteArray  data;
+    QDataStream stream(&data, QIODevice::WriteOnly);
+    stream.setVersion(QDataStream::Qt_5_6);
+    stream << ticket->name() << ticket->place() << ticket->discount() << ticket->userIndex();
+    return data;
+}
+
+static bool deserializeSeasonTicket(quint32 index, const QByteArray& data, SeasonTicketValues& values)
+{
+    QDataStream stream(data);
+    stream.setVersion(QDataStream::Qt_5_6);
+
+    stream >> values.m_name >> values.m_place >> values.m_discount >> values.m_userIndex;
+    values.m_index = index;
+    return stream.status() == QDataStream::Ok;
+}
+
 
 GlobalData::GlobalData(QObject* parent)
     : QObject(parent)
@@ -52,6 +99,17 @@ GlobalData::GlobalData(QObject* parent)
     QGuiApplication::setApplicationName("StamOrga");
     this->setbIsConnected(false);
     this->SetUserProperties(0x0);
+    this->m_bPushActive              = false;
+    this->m_pushLastContactTimeStamp = 0;
+
+    this->m_gpLastLocalUpdateTimeStamp    = 0;
+    this->m_gpLastServerUpdateTimeStamp   = 0;
+    this->m_bGamePlayClearedSinceSave     = false;
+    this->m_bGamePlayUpdateAll            = false;
+    this->m_stLastLocalUpdateTimeStamp    = 0;
+    this->m_stLastServerUpdateTimeStamp   = 0;
+    this->m_bSeasonTicketClearedSinceSave = false;
+    this->m_bSeasonTicketUpdateAll        = false;
 
     this->m_logApp = new Logging();
     this->m_logApp->initialize();
@@ -61,6 +119,53 @@ GlobalData::GlobalData(QObject* parent)
 
     this->m_pMainUserSettings = new QSettings();
     this->m_pMainUserSettings->setIniCodec(("UTF-8"));
+
+    this->m_cacheWriter = new LocalCacheWriter();
+    this->m_ctrlCache.Start(this->m_cacheWriter, false);
+    this->m_gamesCache   = new LocalCache(getUserAppDataLocation() + CACHE_GAMES_FILE, this->m_cacheWriter);
+    this->m_ticketsCache = new LocalCache(getUserAppDataLocation() + CACHE_TICKETS_FILE, this->m_cacheWriter);
+    connect(this->m_gamesCache, &LocalCache::signalReadFinished, this, &GlobalData::slotGamesCacheRead);
+    connect(this->m_ticketsCache, &LocalCache::signalReadFinished, this, &GlobalData::slotSeasonTicketsCacheRead);
+
+    this->m_startupFirstFrame     = -1;
+    this->m_bStartupGamesLoaded   = false;
+    this->m_bStartupTicketsLoaded = false;
+    this->m_bStartupInteractive   = false;
+    this->m_startupTimer.start();
+}
+
+void GlobalData::setStartupTimer(const QElapsedTimer& timer)
+{
+    this->m_startupTimer = timer;
+}
+
+/* Called with the first frame the window has shown, only the first call is used */
+void GlobalData::slotStartupFirstFrame()
+{
+    if (this->sender() != NULL)
+        disconnect(this->sender(), 0, this, SLOT(slotStartupFirstFrame()));
+    if (this->m_startupFirstFrame >= 0)
+        return;
+
+    this->m_startupFirstFrame = this->m_startupTimer.elapsed();
+    qInfo().noquote() << QString("Startup: first frame after %1 ms").arg(this->m_startupFirstFrame);
+
+    this->checkStartupInteractive();
+}
+
+/* The app is interactive when the window is shown and the cached lists are in the models */
+void GlobalData::checkStartupInteractive()
+{
+    if (this->m_bStartupInteractive || this->m_startupFirstFrame < 0)
+        return;
+    if (!this->m_bStartupGamesLoaded || !this->m_bStartupTicketsLoaded)
+        return;
+
+    this->m_bStartupInteractive = true;
+    qInfo().noquote() << QString("Startup: interactive after %1 ms with %2 games and %3 tickets")
+                             .arg(this->m_startupTimer.elapsed())
+                             .arg(this->getGamePlayLength())
+                             .arg(this->getSeasonTicketLength());
 }
 
 void GlobalData::loadGlobalSettings()
@@ -91,56 +196,158 @@ void GlobalData::loadGlobalSettings()
         if (this->m_pMainUserSettings->childGroups().length() > 0 || this->m_pMainUserSettings->childKeys().length() > 0)
             this->m_pMainUserSettings->remove("");
         this->m_pMainUserSettings->endGroup();
+        this->m_gamesCache->remove();
+        this->m_ticketsCache->remove();
+        this->m_bStartupGamesLoaded   = true;
+        this->m_bStartupTicketsLoaded = true;
+        this->checkStartupInteractive();
         return;
     }
 
-    /* Getting data from last Games */
+    /* the cached lists are read in the background, the window is shown meanwhile */
+    this->m_gamesCache->startRead();
+    this->m_ticketsCache->startRead();
+}
+
+void GlobalData::slotGamesCacheRead()
+{
+    QList<CacheItem> items;
+    qint64           localTime, serverTime;
+    bool             bRead = this->m_gamesCache->takeReadResult(items, localTime, serverTime);
+
+    /* locked as a whole, the data connection could update the games from the server meanwhile */
+    {
+        QMutexLocker lock(&this->m_mutexGame);
+        if (this->m_gpLastLocalUpdateTimeStamp != 0)
+            qInfo().noquote() << "Games were already updated from the server, cached games are not used";
+        else {
+            if (bRead)
+                this->loadGamesFromCache(items, localTime, serverTime);
+            else
+                this->migrateGamesFromSettings();
+
+            this->m_bGamePlayLastUpdateDidChanges = false;
+            this->m_bGamePlayClearedSinceSave     = false;
+            this->m_gpChangedSinceSave.clear();
+        }
+    }
+
+    this->m_bStartupGamesLoaded = true;
+    emit this->gamePlayListLoaded();
+    this->checkStartupInteractive();
+}
+
+void GlobalData::slotSeasonTicketsCacheRead()
+{
+    QList<CacheItem> items;
+    qint64           localTime, serverTime;
+    bool             bRead = this->m_ticketsCache->takeReadResult(items, localTime, serverTime);
+
+    {
+        QMutexLocker lock(&this->m_mutexTicket);
+        if (this->m_stLastLocalUpdateTimeStamp != 0)
+            qInfo().noquote() << "Tickets were already updated from the server, cached tickets are not used";
+        else {
+            if (bRead)
+                this->loadSeasonTicketsFromCache(items, localTime, serverTime);
+            else
+                this->migrateSeasonTicketsFromSettings();
+
+            this->m_bSeasonTicketLastUpdateDidChanges = false;
+            this->m_bSeasonTicketClearedSinceSave     = false;
+            this->m_stChangedSinceSave.clear();
+        }
+    }
+
+    this->m_bStartupTicketsLoaded = true;
+    emit this->seasonTicketListLoaded();
+    this->checkStartupInteractive();
+}
+
+void GlobalData::loadGamesFromCache(const QList<CacheItem>& items, qint64 localTime, qint64 serverTime)
+{
+    GamePlayValues values;
+    foreach (const CacheItem& item, items) {
+        if (deserializeGamePlay(item.first, item.second, values))
+            this->updateGamePlay(values, UpdateIndex::UpdateAll);
+    }
+
+    std::sort(this->m_lGamePlay.begin(), this->m_lGamePlay.end(), GamePlay::compareTimeStampFunction);
+    this->m_gpLastLocalUpdateTimeStamp  = localTime;
+    this->m_gpLastServerUpdateTimeStamp = serverTime;
+}
+
+/* Reads the games of older versions from the settings and moves them to the cache */
+void GlobalData::migrateGamesFromSettings()
+{
     this->m_pMainUserSettings->beginGroup(GAMES_GROUP);
     this->m_gpLastLocalUpdateTimeStamp  = this->m_pMainUserSettings->value("LocalGamesUpdateTime", 0).toLongLong();
     this->m_gpLastServerUpdateTimeStamp = this->m_pMainUserSettings->value("ServerGamesUpdateTime", 0).toLongLong();
     int count                           = this->m_pMainUserSettings->beginReadArray(GROUP_ARRAY_ITEM);
     for (int i = 0; i < count; i++) {
         this->m_pMainUserSettings->setArrayIndex(i);
-        GamePlay* play = new GamePlay();
-        play->setHome(this->m_pMainUserSettings->value(PLAY_HOME, "").toString());
-        play->setAway(this->m_pMainUserSettings->value(PLAY_AWAY, "").toString());
-        play->setTimeStamp(this->m_pMainUserSettings->value(PLAY_DATETIME, 0).toLongLong());
-        play->setSeasonIndex(quint8(this->m_pMainUserSettings->value(PLAY_SAISON_INDEX, 0).toUInt()));
-        play->setIndex(this->m_pMainUserSettings->value(ITEM_INDEX, 0).toUInt());
-        play->setScore(this->m_pMainUserSettings->value(PLAY_SCORE, "").toString());
-        play->setCompetition(CompetitionIndex(quint8(this->m_pMainUserSettings->value(PLAY_COMPETITION, 0).toUInt())));
-        play->setTimeFixed(this->m_pMainUserSettings->value(PLAY_TIME_FIXED, false).toBool());
-
-        QQmlEngine::setObjectOwnership(play, QQmlEngine::CppOwnership);
-        this->addNewGamePlay(play);
+        GamePlayValues values;
+        values.m_home        = this->m_pMainUserSettings->value(PLAY_HOME, "").toString();
+        values.m_away        = this->m_pMainUserSettings->value(PLAY_AWAY, "").toString();
+        values.m_timestamp   = this->m_pMainUserSettings->value(PLAY_DATETIME, 0).toLongLong();
+        values.m_seasonIndex = quint8(this->m_pMainUserSettings->value(PLAY_SAISON_INDEX, 0).toUInt());
+        values.m_index       = this->m_pMainUserSettings->value(ITEM_INDEX, 0).toUInt();
+        values.m_score       = this->m_pMainUserSettings->value(PLAY_SCORE, "").toString();
+        values.m_competition = CompetitionIndex(quint8(this->m_pMainUserSettings->value(PLAY_COMPETITION, 0).toUInt()));
+        values.m_timeFixed   = this->m_pMainUserSettings->value(PLAY_TIME_FIXED, false).toBool();
+        this->updateGamePlay(values, UpdateIndex::UpdateAll);
     }
     this->m_pMainUserSettings->endArray();
+    this->m_pMainUserSettings->remove("");
     this->m_pMainUserSettings->endGroup();
-    this->m_bGamePlayLastUpdateDidChanges = false;
 
-    /* Getting data from last SeasonTickets */
+    QList<CacheItem> items;
+    foreach (GamePlay* play, this->m_lGamePlay)
+        items.append(CacheItem(play->index(), serializeGamePlay(play)));
+    this->m_gamesCache->writeAll(items, this->m_gpLastLocalUpdateTimeStamp, this->m_gpLastServerUpdateTimeStamp);
+}
+
+void GlobalData::loadSeasonTicketsFromCache(const QList<CacheItem>& items, qint64 localTime, qint64 serverTime)
+{
+    SeasonTicketValues values;
+    quint32            userIndex = this->userIndex();
+    foreach (const CacheItem& item, items) {
+        if (deserializeSeasonTicket(item.first, item.second, values))
+            this->updateSeasonTicket(values, UpdateIndex::UpdateAll, userIndex);
+    }
+
+    this->m_stLastLocalUpdateTimeStamp  = localTime;
+    this->m_stLastServerUpdateTimeStamp = serverTime;
+}
+
+/* Reads the tickets of older versions from the settings and moves them to the cache */
+void GlobalData::migrateSeasonTicketsFromSettings()
+{
     this->m_pMainUserSettings->beginGroup(SEASONTICKET_GROUP);
     this->m_stLastLocalUpdateTimeStamp  = this->m_pMainUserSettings->value("LocalTicketsUpdateTime", 0).toLongLong();
     this->m_stLastServerUpdateTimeStamp = this->m_pMainUserSettings->value("ServerTicketsUpdateTime", 0).toLongLong();
 
-    int ticketCount = this->m_pMainUserSettings->beginReadArray(GROUP_ARRAY_ITEM);
+    quint32 userIndex   = this->userIndex();
+    int     ticketCount = this->m_pMainUserSettings->beginReadArray(GROUP_ARRAY_ITEM);
     for (int i = 0; i < ticketCount; i++) {
         this->m_pMainUserSettings->setArrayIndex(i);
-        SeasonTicketItem* ticket = new SeasonTicketItem();
-
-        ticket->setName(this->m_pMainUserSettings->value(TICKET_NAME, "").toString());
-        ticket->setPlace(this->m_pMainUserSettings->value(TICKET_PLACE, "").toString());
-        ticket->setDiscount(quint8(this->m_pMainUserSettings->value(TICKET_DISCOUNT, 0).toUInt()));
-        ticket->setIndex(this->m_pMainUserSettings->value(ITEM_INDEX, 0).toUInt());
-        ticket->setUserIndex(this->m_pMainUserSettings->value(TICKET_USER_INDEX, 0).toUInt());
-
-        QQmlEngine::setObjectOwnership(ticket, QQmlEngine::CppOwnership);
-        this->addNewSeasonTicket(ticket);
+        SeasonTicketValues values;
+        values.m_name      = this->m_pMainUserSettings->value(TICKET_NAME, "").toString();
+        values.m_place     = this->m_pMainUserSettings->value(TICKET_PLACE, "").toString();
+        values.m_discount  = quint8(this->m_pMainUserSettings->value(TICKET_DISCOUNT, 0).toUInt());
+        values.m_index     = this->m_pMainUserSettings->value(ITEM_INDEX, 0).toUInt();
+        values.m_userIndex = this->m_pMainUserSettings->value(TICKET_USER_INDEX, 0).toUInt();
+        this->updateSeasonTicket(values, UpdateIndex::UpdateAll, userIndex);
     }
 
     this->m_pMainUserSettings->endArray();
+    this->m_pMainUserSettings->remove("");
     this->m_pMainUserSettings->endGroup();
-    this->m_bSeasonTicketLastUpdateDidChanges = false;
+
+    QList<CacheItem> items;
+    foreach (SeasonTicketItem* ticket, this->m_lSeasonTicket)
+        items.append(CacheItem(ticket->index(), serializeSeasonTicket(ticket)));
+    this->m_ticketsCache->writeAll(items, this->m_stLastLocalUpdateTimeStamp, this->m_stLastServerUpdateTimeStamp);
 }
 
 void GlobalData::saveGlobalUserSettings()
@@ -174,98 +381,101 @@ void GlobalData::saveCurrentGamesList(qint64 timestamp)
     if (!g_GlobalSettings->saveInfosOnApp())
         return;
 
-    this->m_pMainUserSettings->beginGroup(GAMES_GROUP);
-    this->m_pMainUserSettings->remove(""); // clear all elements
-
-    this->m_pMainUserSettings->setValue("LocalGamesUpdateTime", this->m_gpLastLocalUpdateTimeStamp);
-    this->m_pMainUserSettings->setValue("ServerGamesUpdateTime", this->m_gpLastServerUpdateTimeStamp);
-
-    this->m_pMainUserSettings->beginWriteArray(GROUP_ARRAY_ITEM);
-    for (int i = 0; i < this->m_lGamePlay.size(); i++) {
-        this->m_pMainUserSettings->setArrayIndex(i);
-        this->m_pMainUserSettings->setValue(PLAY_HOME, this->m_lGamePlay[i]->home());
-        this->m_pMainUserSettings->setValue(PLAY_AWAY, this->m_lGamePlay[i]->away());
-        this->m_pMainUserSettings->setValue(PLAY_DATETIME, this->m_lGamePlay[i]->timestamp64Bit());
-        this->m_pMainUserSettings->setValue(PLAY_SAISON_INDEX, this->m_lGamePlay[i]->seasonIndex());
-        this->m_pMainUserSettings->setValue(ITEM_INDEX, this->m_lGamePlay[i]->index());
-        this->m_pMainUserSettings->setValue(PLAY_SCORE, this->m_lGamePlay[i]->score());
-        this->m_pMainUserSettings->setValue(PLAY_COMPETITION, this->m_lGamePlay[i]->competitionValue());
-        this->m_pMainUserSettings->setValue(PLAY_TIME_FIXED, this->m_lGamePlay[i]->timeFixed());
+    /* Only the changed games are appended to the cache, the whole file is written again when it got too long */
+    QList<CacheItem> items;
+    if (this->m_gamesCache->needsCompaction(this->m_lGamePlay.size())) {
+        foreach (GamePlay* play, this->m_lGamePlay)
+            items.append(CacheItem(play->index(), serializeGamePlay(play)));
+        this->m_gamesCache->writeAll(items, this->m_gpLastLocalUpdateTimeStamp, this->m_gpLastServerUpdateTimeStamp);
+    } else {
+        foreach (quint32 index, this->m_gpChangedSinceSave) {
+            GamePlay* play = this->m_hGamePlay.value(index, NULL);
+            if (play != NULL)
+                items.append(CacheItem(index, serializeGamePlay(play)));
+        }
+        this->m_gamesCache->writeChanges(this->m_bGamePlayClearedSinceSave, items,
+                                         this->m_gpLastLocalUpdateTimeStamp, this->m_gpLastServerUpdateTimeStamp);
     }
 
-    this->m_pMainUserSettings->endArray();
-    this->m_pMainUserSettings->endGroup();
+    this->m_gpChangedSinceSave.clear();
+    this->m_bGamePlayClearedSinceSave = false;
 }
 
+/* With UpdateAll the known games are kept and updated, finishUpdateGamesPlay removes the ones not send again */
 void GlobalData::startUpdateGamesPlay(const qint16 updateIndex)
 {
     QMutexLocker lock(&this->m_mutexGame);
 
-    /* need to delet, because they are all pointers */
-    if (updateIndex == UpdateIndex::UpdateAll) {
-        for (int i = 0; i < this->m_lGamePlay.size(); i++)
-            delete this->m_lGamePlay[i];
-        this->m_lGamePlay.clear();
-        this->m_bGamePlayLastUpdateDidChanges = true;
-    } else
-        this->m_bGamePlayLastUpdateDidChanges = false;
+    this->m_bGamePlayUpdateAll            = updateIndex == UpdateIndex::UpdateAll;
+    this->m_bGamePlayLastUpdateDidChanges = false;
+    this->m_gpSeenInUpdate.clear();
 
     this->m_gpLastLocalUpdateTimeStamp = QDateTime::currentDateTime().toMSecsSinceEpoch();
 }
 
-void GlobalData::addNewGamePlay(GamePlay* gPlay, const qint16 updateIndex)
+void GlobalData::finishUpdateGamesPlay()
 {
-    GamePlay* play = this->getGamePlay(gPlay->index());
+    QMutexLocker lock(&this->m_mutexGame);
+
+    if (!this->m_bGamePlayUpdateAll)
+        return;
+    this->m_bGamePlayUpdateAll = false;
+
+    bool bRemoved = false;
+    for (int i = this->m_lGamePlay.size() - 1; i >= 0; i--) {
+        GamePlay* play = this->m_lGamePlay[i];
+        if (this->m_gpSeenInUpdate.contains(play->index()))
+            continue;
+        this->m_hGamePlay.remove(play->index());
+        this->m_lGamePlay.removeAt(i);
+        delete play;
+        bRemoved = true;
+    }
+    this->m_gpSeenInUpdate.clear();
+
+    /* the cache can not remove a single game, so it is written again */
+    if (bRemoved) {
+        foreach (GamePlay* play, this->m_lGamePlay)
+            this->m_gpChangedSinceSave.insert(play->index());
+        this->m_bGamePlayClearedSinceSave     = true;
+        this->m_bGamePlayLastUpdateDidChanges = true;
+    }
+}
+
+void GlobalData::addNewGamePlay(const GamePlayValues& values, const qint16 updateIndex)
+{
+    QMutexLocker lock(&this->m_mutexGame);
+    this->updateGamePlay(values, updateIndex);
+}
+
+/* Only creates a game when it is not known yet, known games only change the values that differ */
+void GlobalData::updateGamePlay(const GamePlayValues& values, const qint16 updateIndex)
+{
+    GamePlay* play = this->m_hGamePlay.value(values.m_index, NULL);
     if (play == NULL) {
-        QMutexLocker lock(&this->m_mutexGame);
+        play = new GamePlay();
+        play->setValues(values);
+        play->setEnableAddGame(this->userIsGameAddingEnabled());
+        QQmlEngine::setObjectOwnership(play, QQmlEngine::CppOwnership);
 
-        gPlay->setEnableAddGame(this->userIsGameAddingEnabled());
-        this->m_lGamePlay.append(gPlay);
+        this->m_lGamePlay.append(play);
+        this->m_hGamePlay.insert(play->index(), play);
+        this->m_gpChangedSinceSave.insert(play->index());
+        this->m_bGamePlayLastUpdateDidChanges = true;
+    } else if (play->setValues(values)) {
+        this->m_gpChangedSinceSave.insert(play->index());
         this->m_bGamePlayLastUpdateDidChanges = true;
-        return;
-    } else if (updateIndex == UpdateIndex::UpdateDiff) {
-        if (play->home() != gPlay->home()) {
-            play->setHome(gPlay->home());
-            this->m_bGamePlayLastUpdateDidChanges = true;
-        }
-        if (play->away() != gPlay->away()) {
-            play->setAway(gPlay->away());
-            this->m_bGamePlayLastUpdateDidChanges = true;
-        }
-        if (play->score() != gPlay->score()) {
-            play->setScore(gPlay->score());
-            this->m_bGamePlayLastUpdateDidChanges = true;
-        }
-        if (play->timestamp64Bit() != gPlay->timestamp64Bit()) {
-            play->setTimeStamp(gPlay->timestamp64Bit());
-            this->m_bGamePlayLastUpdateDidChanges = true;
-        }
-        if (play->seasonIndex() != gPlay->seasonIndex()) {
-            play->setSeasonIndex(gPlay->seasonIndex());
-            this->m_bGamePlayLastUpdateDidChanges = true;
-        }
-        if (play->competitionValue() != gPlay->competitionValue()) {
-            play->setCompetition((CompetitionIndex)gPlay->competitionValue());
-            this->m_bGamePlayLastUpdateDidChanges = true;
-        }
-        if (play->timeFixed() != gPlay->timeFixed()) {
-            play->setTimeFixed(gPlay->timeFixed());
-            this->m_bGamePlayLastUpdateDidChanges = true;
-        }
     }
 
-    delete gPlay;
+    if (updateIndex == UpdateIndex::UpdateAll && this->m_bGamePlayUpdateAll)
+        this->m_gpSeenInUpdate.insert(play->index());
 }
 
 GamePlay* GlobalData::getGamePlay(const quint32 gameIndex)
 {
     QMutexLocker lock(&this->m_mutexGame);
 
-    for (int i = 0; i < this->m_lGamePlay.size(); i++) {
-        if (this->m_lGamePlay[i]->index() == gameIndex)
-            return this->m_lGamePlay[i];
-    }
-    return NULL;
+    return this->m_hGamePlay.value(gameIndex, NULL);
 }
 
 GamePlay* GlobalData::getGamePlayFromArrayIndex(int index)
@@ -277,6 +487,37 @@ GamePlay* GlobalData::getGamePlayFromArrayIndex(int index)
     return NULL;
 }
 
+/* Copies the values of all games with one lock, so the models do not need to ask for every item */
+void GlobalData::getGamePlayRows(QVector<GamePlayRow>& rows)
+{
+    QMutexLocker lock(&this->m_mutexGame);
+
+    rows.clear();
+    rows.reserve(this->m_lGamePlay.size());
+    foreach (GamePlay* play, this->m_lGamePlay) {
+        GamePlayRow row;
+        row.m_index             = play->index();
+        row.m_home              = play->home();
+        row.m_away              = play->away();
+        row.m_score             = play->score();
+        row.m_timestamp         = play->timestamp64Bit();
+        row.m_dateLine          = play->timestampReadableLine();
+        row.m_competitionLine   = play->getCompetitionLine() + play->competition();
+        row.m_competition       = play->competitionValue();
+        row.m_seasonIndex       = play->seasonIndex();
+        row.m_timeFixed         = play->timeFixed();
+        row.m_bInPast           = play->isGameInPast();
+        row.m_bRunning          = play->isGameRunning();
+        row.m_bSeasonTicketGame = play->isGameASeasonTicketGame();
+        row.m_freeTickets       = play->getFreeTickets();
+        row.m_acceptedMeeting   = play->getAcceptedMeetingCount();
+        row.m_interestedMeeting = play->getInterestedMeetingCount();
+        row.m_declinedMeeting   = play->getDeclinedMeetingCount();
+        row.m_meetingInfo       = play->getMeetingInfo();
+        rows.append(row);
+    }
+}
+
 QString GlobalData::getGamePlayLastUpdateString()
 {
     QMutexLocker lock(&this->m_mutexGame);
@@ -305,67 +546,95 @@ void GlobalData::saveCurrentSeasonTickets(qint64 timestamp)
     if (!g_GlobalSettings->saveInfosOnApp())
         return;
 
-    this->m_pMainUserSettings->beginGroup(SEASONTICKET_GROUP);
-    this->m_pMainUserSettings->remove(""); // clear all elements
-
-    this->m_pMainUserSettings->setValue("LocalTicketsUpdateTime", this->m_stLastLocalUpdateTimeStamp);
-    this->m_pMainUserSettings->setValue("ServerTicketsUpdateTime", this->m_stLastServerUpdateTimeStamp);
-
-    this->m_pMainUserSettings->beginWriteArray(GROUP_ARRAY_ITEM);
-    for (int i = 0; i < this->m_lSeasonTicket.size(); i++) {
-        this->m_pMainUserSettings->setArrayIndex(i);
-        this->m_pMainUserSettings->setValue(TICKET_NAME, this->m_lSeasonTicket[i]->name());
-        this->m_pMainUserSettings->setValue(TICKET_PLACE, this->m_lSeasonTicket[i]->place());
-        this->m_pMainUserSettings->setValue(TICKET_DISCOUNT, this->m_lSeasonTicket[i]->discount());
-        ;
-        this->m_pMainUserSettings->setValue(ITEM_INDEX, this->m_lSeasonTicket[i]->index());
-        ;
-        this->m_pMainUserSettings->setValue(TICKET_USER_INDEX, this->m_lSeasonTicket[i]->userIndex());
-        ;
+    QList<CacheItem> items;
+    if (this->m_ticketsCache->needsCompaction(this->m_lSeasonTicket.size())) {
+        foreach (SeasonTicketItem* ticket, this->m_lSeasonTicket)
+            items.append(CacheItem(ticket->index(), serializeSeasonTicket(ticket)));
+        this->m_ticketsCache->writeAll(items, this->m_stLastLocalUpdateTimeStamp, this->m_stLastServerUpdateTimeStamp);
+    } else {
+        foreach (quint32 index, this->m_stChangedSinceSave) {
+            SeasonTicketItem* ticket = this->m_hSeasonTicket.value(index, NULL);
+            if (ticket != NULL)
+                items.append(CacheItem(index, serializeSeasonTicket(ticket)));
+        }
+        this->m_ticketsCache->writeChanges(this->m_bSeasonTicketClearedSinceSave, items,
+                                           this->m_stLastLocalUpdateTimeStamp, this->m_stLastServerUpdateTimeStamp);
     }
 
-    this->m_pMainUserSettings->endArray();
-    this->m_pMainUserSettings->endGroup();
+    this->m_stChangedSinceSave.clear();
+    this->m_bSeasonTicketClearedSinceSave = false;
 }
 
+/* The server always sends all tickets, the known ones are kept and updated like the games */
 void GlobalData::startUpdateSeasonTickets(const quint16 updateIndex)
 {
     QMutexLocker lock(&this->m_mutexTicket);
 
-    if (updateIndex == UpdateIndex::UpdateAll) {
-        /* need to delete, because they are all pointers */
-        for (int i = 0; i < this->m_lSeasonTicket.size(); i++)
-            delete this->m_lSeasonTicket[i];
-        this->m_lSeasonTicket.clear();
-        this->m_bSeasonTicketLastUpdateDidChanges = true;
-    } else
-        this->m_bSeasonTicketLastUpdateDidChanges = false;
+    this->m_bSeasonTicketUpdateAll            = updateIndex == UpdateIndex::UpdateAll;
+    this->m_bSeasonTicketLastUpdateDidChanges = false;
+    this->m_stSeenInUpdate.clear();
 
     this->m_stLastLocalUpdateTimeStamp = QDateTime::currentDateTime().toMSecsSinceEpoch();
 }
 
-void GlobalData::addNewSeasonTicket(SeasonTicketItem* sTicket, const quint16 updateIndex)
+void GlobalData::finishUpdateSeasonTickets()
 {
-    SeasonTicketItem* ticket = this->getSeasonTicket(sTicket->index());
+    QMutexLocker lock(&this->m_mutexTicket);
+
+    if (!this->m_bSeasonTicketUpdateAll)
+        return;
+    this->m_bSeasonTicketUpdateAll = false;
+
+    bool bRemoved = false;
+    for (int i = this->m_lSeasonTicket.size() - 1; i >= 0; i--) {
+        SeasonTicketItem* ticket = this->m_lSeasonTicket[i];
+        if (this->m_stSeenInUpdate.contains(ticket->index()))
+            continue;
+        this->m_hSeasonTicket.remove(ticket->index());
+        this->m_lSeasonTicket.removeAt(i);
+        delete ticket;
+        bRemoved = true;
+    }
+    this->m_stSeenInUpdate.clear();
+
+    if (bRemoved) {
+        foreach (SeasonTicketItem* ticket, this->m_lSeasonTicket)
+            this->m_stChangedSinceSave.insert(ticket->index());
+        this->m_bSeasonTicketClearedSinceSave     = true;
+        this->m_bSeasonTicketLastUpdateDidChanges = true;
+    }
+}
+
+void GlobalData::addNewSeasonTicket(const SeasonTicketValues& values, const quint16 updateIndex)
+{
+    quint32 userIndex = this->userIndex();
+
+    QMutexLocker lock(&this->m_mutexTicket);
+    this->updateSeasonTicket(values, updateIndex, userIndex);
+}
+
+void GlobalData::updateSeasonTicket(const SeasonTicketValues& values, const quint16 updateIndex, const quint32 userIndex)
+{
+    SeasonTicketItem* ticket = this->m_hSeasonTicket.value(values.m_index, NULL);
     if (ticket == NULL) {
-        QMutexLocker lock(&this->m_mutexTicket);
-        this->m_lSeasonTicket.append(sTicket);
+        ticket = new SeasonTicketItem();
+        ticket->setValues(values);
+        ticket->checkTicketOwn(userIndex);
+        QQmlEngine::setObjectOwnership(ticket, QQmlEngine::CppOwnership);
+
+        this->m_lSeasonTicket.append(ticket);
+        this->m_hSeasonTicket.insert(ticket->index(), ticket);
+        this->m_stChangedSinceSave.insert(ticket->index());
+        this->m_bSeasonTicketLastUpdateDidChanges = true;
+    } else if (ticket->setValues(values)) {
+        ticket->checkTicketOwn(userIndex);
+
+        this->m_stChangedSinceSave.insert(ticket->index());
         this->m_bSeasonTicketLastUpdateDidChanges = true;
-        return;
-    } else if (updateIndex == UpdateIndex::UpdateDiff) {
-        if (ticket->name() != sTicket->name()) {
-            ticket->setName(sTicket->name());
-            this->m_bSeasonTicketLastUpdateDidChanges = true;
-        }
-        if (ticket->place() != sTicket->place()) {
-            ticket->setPlace(sTicket->place());
-            this->m_bSeasonTicketLastUpdateDidChanges = true;
-        }
-        if (ticket->discount() != sTicket->discount()) {
-            ticket->setDiscount(sTicket->discount());
-            this->m_bSeasonTicketLastUpdateDidChanges = true;
-        }
     }
+
+    if (updateIndex == UpdateIndex::UpdateAll && this->m_bSeasonTicketUpdateAll)
+        this->m_stSeenInUpdate.insert(ticket->index());
 }
 
 SeasonTicketItem* GlobalData::getSeasonTicketFromArrayIndex(int index)
@@ -382,11 +651,24 @@ SeasonTicketItem* GlobalData::getSeasonTicket(quint32 ticketIndex)
 {
     QMutexLocker lock(&this->m_mutexTicket);
 
-    for (int i = 0; i < this->m_lSeasonTicket.size(); i++) {
-        if (this->m_lSeasonTicket[i]->index() == ticketIndex)
-            return this->m_lSeasonTicket[i];
+    return this->m_hSeasonTicket.value(ticketIndex, NULL);
+}
+
+void GlobalData::getSeasonTicketRows(QVector<SeasonTicketRow>& rows)
+{
+    QMutexLocker lock(&this->m_mutexTicket);
+
+    rows.clear();
+    rows.reserve(this->m_lSeasonTicket.size());
+    foreach (SeasonTicketItem* ticket, this->m_lSeasonTicket) {
+        SeasonTicketRow row;
+        row.m_index     = ticket->index();
+        row.m_name      = ticket->name();
+        row.m_place     = ticket->place();
+        row.m_discount  = ticket->discount();
+        row.m_ownTicket = ticket->isTicketYourOwn();
+        rows.append(row);
     }
-    return NULL;
 }
 
 QString GlobalData::getSeasonTicketLastLocalUpdateString()
@@ -407,6 +689,34 @@ qint64 GlobalData::getSeasonTicketLastServerUpdate()
     return this->m_stLastServerUpdateTimeStamp;
 }
 
+void GlobalData::setPushActive(const bool active)
+{
+    QMutexLocker lock(&this->m_mutexUser);
+    this->m_bPushActive = active;
+    if (active)
+        this->m_pushLastContactTimeStamp = QDateTime::currentMSecsSinceEpoch();
+}
+
+void GlobalData::setPushLastContact(const qint64 timestamp)
+{
+    QMutexLocker lock(&this->m_mutexUser);
+    this->m_pushLastContactTimeStamp = timestamp;
+}
+
+/* Pushes are only reliable as long as the server still holds our data connection */
+bool GlobalData::isPushUpToDate()
+{
+    QMutexLocker lock(&this->m_mutexUser);
+    if (!this->m_bPushActive)
+        return false;
+
+    qint64 now = QDateTime::currentMSecsSinceEpoch();
+    if ((now - this->m_pushLastContactTimeStamp) > CON_RESET_TIMEOUT_MSEC)
+        return false;
+
+    return true;
+}
+
 void GlobalData::copyTextToClipBoard(QString text)
 {
     QClipboard* clip = QGuiApplication::clipboard();
@@ -19,9 +19,12 @@
 #ifndef GLOBALDATA_H
 #define GLOBALDATA_H
 
+#include <QtCore/QElapsedTimer>
+#include <QtCore/QHash>
 #include <QtCore/QList>
 #include <QtCore/QMutex>
 #include <QtCore/QObject>
+#include <QtCore/QSet>
 #include <QtCore/QSettings>
 #include <QtNetwork/QHostInfo>
 
@@ -29,8 +32,11 @@
 #include "../../Common/General/globalfunctions.h"
 #include "../../Common/General/logging.h"
 #include "gameplay.h"
+#include "gameplaymodel.h"
+#include "localcache.h"
 #include "meetinginfo.h"
 #include "seasonticket.h"
+#include "seasonticketmodel.h"
 
 
 #define USER_IS_ENABLED(val) ((this->m_UserProperties & val) > 0 ? true : false)
@@ -177,9 +183,17 @@ public:
 
     void saveGlobalUserSettings();
 
-    Q_INVOKABLE QString getCurrentLoggingList(int index)
+    Q_INVOKABLE QString getCurrentLoggingList(int index, int page = 0)
     {
-        return this->m_logApp->getCurrentLoggingList(index);
+        return this->m_logApp->getCurrentLoggingList(index, page);
+    }
+
+    Q_INVOKABLE QString findLoggingLines(QString query)
+    {
+        QStringList lines;
+        if (this->m_logApp->findLogLines(query, lines) != ERROR_CODE_SUCCESS)
+            return "Wrong query, use user=NAME game=INDEX since=hh:mm";
+        return lines.join("\n");
     }
 
     Q_INVOKABLE QStringList getCurrentLogFileList()
@@ -192,14 +206,16 @@ public:
     void saveCurrentGamesList(qint64 timestamp);
 
     void startUpdateGamesPlay(const qint16 updateIndex);
-    void addNewGamePlay(GamePlay* gPlay, const qint16 updateIndex = 0);
+    void addNewGamePlay(const GamePlayValues& values, const qint16 updateIndex);
+    void finishUpdateGamesPlay();
     Q_INVOKABLE quint32 getGamePlayLength()
     {
         QMutexLocker lock(&this->m_mutexGame);
         return this->m_lGamePlay.size();
     }
-    GamePlay* getGamePlay(const quint32 gameIndex);
+    Q_INVOKABLE GamePlay* getGamePlay(const quint32 gameIndex);
     Q_INVOKABLE GamePlay* getGamePlayFromArrayIndex(int index);
+    void getGamePlayRows(QVector<GamePlayRow>& rows);
     Q_INVOKABLE QString getGamePlayLastUpdateString();
     qint64              getGamePlayLastLocalUpdate();
     qint64              getGamePlayLastServerUpdate();
@@ -208,20 +224,28 @@ public:
     void saveCurrentSeasonTickets(qint64 timestamp);
 
     void startUpdateSeasonTickets(const quint16 updateIndex);
-    void addNewSeasonTicket(SeasonTicketItem* sTicket, const quint16 updateIndex = 0);
+    void addNewSeasonTicket(const SeasonTicketValues& values, const quint16 updateIndex);
+    void finishUpdateSeasonTickets();
     Q_INVOKABLE quint32 getSeasonTicketLength()
     {
         QMutexLocker lock(&this->m_mutexTicket);
         return this->m_lSeasonTicket.size();
     }
     Q_INVOKABLE SeasonTicketItem* getSeasonTicketFromArrayIndex(int index);
-    SeasonTicketItem* getSeasonTicket(quint32 ticketIndex);
+    Q_INVOKABLE SeasonTicketItem* getSeasonTicket(quint32 ticketIndex);
+    void getSeasonTicketRows(QVector<SeasonTicketRow>& rows);
     Q_INVOKABLE QString getSeasonTicketLastLocalUpdateString();
     qint64              getSeasonTicketLastLocalUpdate();
     qint64              getSeasonTicketLastServerUpdate();
 
     Q_INVOKABLE MeetingInfo* getMeetingInfo() { return &this->m_meetingInfo; }
 
+    void setPushActive(const bool active);
+    void setPushLastContact(const qint64 timestamp);
+    bool isPushUpToDate();
+
+    void setStartupTimer(const QElapsedTimer& timer);
+
 signals:
     void
     userNameChanged();
@@ -230,12 +254,16 @@ signals:
     void ipAddrChanged();
     void conMasterPortChanged();
     void bIsConnectedChanged();
-
+    void gamePlayListLoaded();
+    void seasonTicketListLoaded();
 
 public slots:
+    void slotStartupFirstFrame();
 
 private slots:
     void callBackLookUpHost(const QHostInfo& host);
+    void slotGamesCacheRead();
+    void slotSeasonTicketsCacheRead();
 
 private:
     QString m_userName;
@@ -258,18 +286,52 @@ private:
 
     QSettings* m_pMainUserSettings;
 
-    QList<GamePlay*> m_lGamePlay;
-    qint64           m_gpLastLocalUpdateTimeStamp;
-    qint64           m_gpLastServerUpdateTimeStamp;
-    bool             m_bGamePlayLastUpdateDidChanges;
-
-    QList<SeasonTicketItem*> m_lSeasonTicket;
-    qint64                   m_stLastLocalUpdateTimeStamp;
-    qint64                   m_stLastServerUpdateTimeStamp;
-    bool                     m_bSeasonTicketLastUpdateDidChanges;
+    QList<GamePlay*>          m_lGamePlay;
+    QHash<quint32, GamePlay*> m_hGamePlay; /* same games by their index */
+    qint64                    m_gpLastLocalUpdateTimeStamp;
+    qint64                    m_gpLastServerUpdateTimeStamp;
+    bool                      m_bGamePlayLastUpdateDidChanges;
+    QSet<quint32>             m_gpChangedSinceSave;
+    bool                      m_bGamePlayClearedSinceSave;
+    bool                      m_bGamePlayUpdateAll;
+    QSet<quint32>             m_gpSeenInUpdate; /* games send by the server with UpdateAll */
+
+    QList<SeasonTicketItem*>          m_lSeasonTicket;
+    QHash<quint32, SeasonTicketItem*> m_hSeasonTicket; /* same tickets by their index */
+    qint64                            m_stLastLocalUpdateTimeStamp;
+    qint64                            m_stLastServerUpdateTimeStamp;
+    bool                              m_bSeasonTicketLastUpdateDidChanges;
+    QSet<quint32>                     m_stChangedSinceSave;
+    bool                              m_bSeasonTicketClearedSinceSave;
+    bool                              m_bSeasonTicketUpdateAll;
+    QSet<quint32>                     m_stSeenInUpdate;
+
+    LocalCacheWriter*    m_cacheWriter;
+    BackgroundController m_ctrlCache;
+    LocalCache*          m_gamesCache;
+    LocalCache*          m_ticketsCache;
+
+    /* these functions need m_mutexGame / m_mutexTicket to be locked by the caller */
+    void updateGamePlay(const GamePlayValues& values, const qint16 updateIndex);
+    void updateSeasonTicket(const SeasonTicketValues& values, const quint16 updateIndex, const quint32 userIndex);
+    void loadGamesFromCache(const QList<CacheItem>& items, qint64 localTime, qint64 serverTime);
+    void migrateGamesFromSettings();
+    void loadSeasonTicketsFromCache(const QList<CacheItem>& items, qint64 localTime, qint64 serverTime);
+    void migrateSeasonTicketsFromSettings();
+
+    QElapsedTimer m_startupTimer;
+    qint64        m_startupFirstFrame;
+    bool          m_bStartupGamesLoaded;
+    bool          m_bStartupTicketsLoaded;
+    bool          m_bStartupInteractive;
+
+    void checkStartupInteractive();
 
     MeetingInfo m_meetingInfo;
 
+    bool   m_bPushActive;
+    qint64 m_pushLastContactTimeStamp;
+
     Logging*             m_logApp;
     BackgroundController m_ctrlLog;
 };
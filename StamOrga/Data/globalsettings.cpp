@@ -137,6 +137,10 @@ void GlobalSettings::stateFromAppChanged(Qt::ApplicationState state)
     if (this->m_pGlobalData->userName() == "" || this->m_pGlobalData->passWord() == "")
         return;
 
+    /* Server pushes all changes, only poll when pushes could have been missed */
+    if (this->m_pGlobalData->isPushUpToDate())
+        return;
+
     qint64 now = QDateTime::currentMSecsSinceEpoch();
     if ((now - this->m_lastGameInfoUpdate) < TIMEOUT_LOAD_GAMEINFO)
         return;
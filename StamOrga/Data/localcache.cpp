@@ -0,0 +1,244 @@
+/*
+*	This file is part of StamOrga
+*   Copyright (C) 2017 Markus Schneider
+*
+*	This program is free software; you can redistribute it and/or modify
+*   it under the terms of the GNU General Public License as published by
+*   the Free Software Foundation; either version 3 of the License, or
+*   (at your option) any later version.
+*
+*	StamOrga is distributed in the hope that it will be useful,
+*    but WITHOUT ANY WARRANTY; without even the implied warranty of
+*    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+*    GNU General Public License for more details.
+
+*    You should have received a copy of the GNU General Public License
+*    along with StamOrga.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include <QtCore/QDataStream>
+#include <QtCore/QDebug>
+#include <QtCore/QDir>
+#include <QtCore/QFile>
+#include <QtCore/QFileInfo>
+#include <QtCore/QHash>
+
+#include "localcache.h"
+
+LocalCacheWriter::LocalCacheWriter()
+    : BackgroundWorker()
+{
+    this->SetWorkerName("LocalCacheWriter");
+}
+
+int LocalCacheWriter::DoBackgroundWork()
+{
+    return 0;
+}
+
+void LocalCacheWriter::slotWriteData(const QString& path, const QByteArray& data, const bool replace)
+{
+    QFileInfo info(path);
+    if (!info.dir().exists() && !info.dir().mkpath(info.dir().absolutePath())) {
+        qWarning().noquote() << QString("Could not create directory for cache %1").arg(path);
+        return;
+    }
+
+    if (!replace) {
+        QFile file(path);
+        if (!file.open(QFile::WriteOnly | QFile::Append) || file.write(data) != data.size())
+            qWarning().noquote() << QString("Could not append to cache %1").arg(path);
+        return;
+    }
+
+    /* write a new file first, so there is always a complete one */
+    QString tmpPath = path + ".tmp";
+    QFile   file(tmpPath);
+    if (!file.open(QFile::WriteOnly | QFile::Truncate) || file.write(data) != data.size()) {
+        qWarning().noquote() << QString("Could not write cache %1").arg(tmpPath);
+        return;
+    }
+    file.close();
+
+    QFile::remove(path);
+    if (!QFile::rename(tmpPath, path))
+        qWarning().noquote() << QString("Could not rename cache %1").arg(tmpPath);
+}
+
+void LocalCacheWriter::slotReadData(LocalCache* cache)
+{
+    cache->readFromWriterThread();
+}
+
+LocalCache::LocalCache(const QString& path, LocalCacheWriter* writer)
+{
+    this->m_path           = path;
+    this->m_bFileValid     = false;
+    this->m_recordCount    = 0;
+    this->m_bReadResult    = false;
+    this->m_readLocalTime  = 0;
+    this->m_readServerTime = 0;
+
+    connect(this, &LocalCache::signalWriteData, writer, &LocalCacheWriter::slotWriteData);
+    connect(this, &LocalCache::signalReadData, writer, &LocalCacheWriter::slotReadData);
+}
+
+void LocalCache::startRead()
+{
+    emit this->signalReadData(this);
+}
+
+void LocalCache::readFromWriterThread()
+{
+    QList<CacheItem> items;
+    qint64           localTime = 0, serverTime = 0;
+    bool             bResult   = this->read(items, localTime, serverTime);
+
+    {
+        QMutexLocker lock(&this->m_mutex);
+        this->m_bReadResult    = bResult;
+        this->m_readItems      = items;
+        this->m_readLocalTime  = localTime;
+        this->m_readServerTime = serverTime;
+    }
+
+    emit this->signalReadFinished();
+}
+
+bool LocalCache::takeReadResult(QList<CacheItem>& items, qint64& localTime, qint64& serverTime)
+{
+    QMutexLocker lock(&this->m_mutex);
+
+    items = this->m_readItems;
+    this->m_readItems.clear();
+    localTime  = this->m_readLocalTime;
+    serverTime = this->m_readServerTime;
+    return this->m_bReadResult;
+}
+
+bool LocalCache::read(QList<CacheItem>& items, qint64& localTime, qint64& serverTime)
+{
+    QMutexLocker lock(&this->m_mutex);
+
+    QFile file(this->m_path);
+    if (!file.open(QFile::ReadOnly))
+        return false;
+
+    qint64     size    = file.size();
+    uchar*     pMapped = size > 0 ? file.map(0, size) : NULL;
+    QByteArray data;
+    if (pMapped != NULL)
+        data = QByteArray::fromRawData((const char*)pMapped, size);
+    else
+        data = file.readAll();
+
+    QDataStream stream(data);
+    stream.setVersion(QDataStream::Qt_5_6);
+
+    quint32 magic;
+    quint16 version;
+    stream >> magic >> version;
+    if (stream.status() != QDataStream::Ok || magic != CACHE_FILE_MAGIC || version != CACHE_FILE_VERSION) {
+        if (pMapped != NULL)
+            file.unmap(pMapped);
+        return false;
+    }
+
+    QHash<quint32, int> positions;
+    bool                bComplete = true;
+    items.clear();
+    this->m_recordCount = 0;
+    while (!stream.atEnd()) {
+        quint8 record;
+        stream >> record;
+        if (record == CACHE_RECORD_CLEAR) {
+            items.clear();
+            positions.clear();
+        } else if (record == CACHE_RECORD_STAMP) {
+            stream >> localTime >> serverTime;
+        } else if (record == CACHE_RECORD_ITEM) {
+            CacheItem item;
+            stream >> item.first >> item.second;
+            if (stream.status() != QDataStream::Ok) {
+                bComplete = false;
+                break;
+            }
+            QHash<quint32, int>::const_iterator it = positions.constFind(item.first);
+            if (it != positions.constEnd())
+                items[it.value()] = item;
+            else {
+                positions.insert(item.first, items.size());
+                items.append(item);
+            }
+        } else {
+            bComplete = false;
+            break;
+        }
+
+        /* a record which was not written completely ends the file */
+        if (stream.status() != QDataStream::Ok) {
+            bComplete = false;
+            break;
+        }
+        this->m_recordCount++;
+    }
+
+    if (pMapped != NULL)
+        file.unmap(pMapped);
+
+    /* the file is written again with the next change */
+    this->m_bFileValid = bComplete;
+    return true;
+}
+
+void LocalCache::remove()
+{
+    QMutexLocker lock(&this->m_mutex);
+
+    QFile::remove(this->m_path);
+    this->m_bFileValid  = false;
+    this->m_recordCount = 0;
+}
+
+bool LocalCache::needsCompaction(int itemCount)
+{
+    QMutexLocker lock(&this->m_mutex);
+
+    return !this->m_bFileValid || this->m_recordCount > 2 * itemCount + 32;
+}
+
+void LocalCache::writeAll(const QList<CacheItem>& items, qint64 localTime, qint64 serverTime)
+{
+    QByteArray  data;
+    QDataStream stream(&data, QIODevice::WriteOnly);
+    stream.setVersion(QDataStream::Qt_5_6);
+
+    stream << CACHE_FILE_MAGIC << CACHE_FILE_VERSION;
+    foreach (const CacheItem& item, items)
+        stream << CACHE_RECORD_ITEM << item.first << item.second;
+    stream << CACHE_RECORD_STAMP << localTime << serverTime;
+
+    QMutexLocker lock(&this->m_mutex);
+    this->m_bFileValid  = true;
+    this->m_recordCount = items.size() + 1;
+
+    emit this->signalWriteData(this->m_path, data, true);
+}
+
+void LocalCache::writeChanges(bool bCleared, const QList<CacheItem>& items, qint64 localTime, qint64 serverTime)
+{
+    QByteArray  data;
+    QDataStream stream(&data, QIODevice::WriteOnly);
+    stream.setVersion(QDataStream::Qt_5_6);
+
+    if (bCleared)
+        stream << CACHE_RECORD_CLEAR;
+    foreach (const CacheItem& item, items)
+        stream << CACHE_RECORD_ITEM << item.first << item.second;
+    stream << CACHE_RECORD_STAMP << localTime << serverTime;
+
+    QMutexLocker lock(&this->m_mutex);
+    this->m_recordCount += items.size() + (bCleared ? 2 : 1);
+
+    emit this->signalWriteData(this->m_path, data, false);
+}
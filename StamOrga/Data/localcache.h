@@ -0,0 +1,99 @@
+/*
+*	This file is part of StamOrga
+*   Copyright (C) 2017 Markus Schneider
+*
+*	This program is free software; you can redistribute it and/or modify
+*   it under the terms of the GNU General Public License as published by
+*   the Free Software Foundation; either version 3 of the License, or
+*   (at your option) any later version.
+*
+*	StamOrga is distributed in the hope that it will be useful,
+*    but WITHOUT ANY WARRANTY; without even the implied warranty of
+*    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+*    GNU General Public License for more details.
+
+*    You should have received a copy of the GNU General Public License
+*    along with StamOrga.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#ifndef LOCALCACHE_H
+#define LOCALCACHE_H
+
+#include <QtCore/QByteArray>
+#include <QtCore/QList>
+#include <QtCore/QMutex>
+#include <QtCore/QObject>
+#include <QtCore/QPair>
+#include <QtCore/QString>
+
+#include "../../Common/General/backgroundworker.h"
+
+// clang-format off
+#define CACHE_FILE_MAGIC        quint32(0x53544341)   /* "STCA" */
+#define CACHE_FILE_VERSION      quint16(1)
+
+#define CACHE_RECORD_CLEAR      quint8(1)
+#define CACHE_RECORD_STAMP      quint8(2)
+#define CACHE_RECORD_ITEM       quint8(3)
+// clang-format on
+
+typedef QPair<quint32, QByteArray> CacheItem;
+
+class LocalCache;
+
+/* Writes the data of all caches in its own thread */
+class LocalCacheWriter : public BackgroundWorker
+{
+    Q_OBJECT
+public:
+    LocalCacheWriter();
+
+public slots:
+    void slotWriteData(const QString& path, const QByteArray& data, const bool replace);
+    void slotReadData(LocalCache* cache);
+
+protected:
+    int DoBackgroundWork() override;
+};
+
+/*
+ * File with records which are only appended. A later record of an item replaces the earlier
+ * one, a clear record removes all items before. When the file holds too many old records
+ * it is written again with only the current items.
+ */
+class LocalCache : public QObject
+{
+    Q_OBJECT
+public:
+    LocalCache(const QString& path, LocalCacheWriter* writer);
+
+    bool read(QList<CacheItem>& items, qint64& localTime, qint64& serverTime);
+    void remove();
+
+    /* reads the file in the thread of the writer, signalReadFinished is emitted when done */
+    void startRead();
+    void readFromWriterThread();
+    bool takeReadResult(QList<CacheItem>& items, qint64& localTime, qint64& serverTime);
+
+    bool needsCompaction(int itemCount);
+    void writeAll(const QList<CacheItem>& items, qint64 localTime, qint64 serverTime);
+    void writeChanges(bool bCleared, const QList<CacheItem>& items, qint64 localTime, qint64 serverTime);
+
+signals:
+    void signalWriteData(const QString& path, const QByteArray& data, const bool replace);
+    void signalReadData(LocalCache* cache);
+    void signalReadFinished();
+
+private:
+    QString m_path;
+    QMutex  m_mutex;
+    bool    m_bFileValid;
+    int     m_recordCount;
+
+    bool             m_bReadResult;
+    QList<CacheItem> m_readItems;
+    qint64           m_readLocalTime;
+    qint64           m_readServerTime;
+};
+
+#endif // LOCALCACHE_H
@@ -25,3 +25,30 @@ SeasonTicketItem::SeasonTicketItem(QObject* parent)
     this->m_ticketState       = TICKET_STATE_BLOCKED;
     this->m_ticketReserveName = "";
 }
+
+/* Only sets the values which differ, returns true when there was one */
+bool SeasonTicketItem::setValues(const SeasonTicketValues& values)
+{
+    bool bChanged = false;
+    if (this->m_index != values.m_index) {
+        this->setIndex(values.m_index);
+        bChanged = true;
+    }
+    if (this->m_userIndex != values.m_userIndex) {
+        this->setUserIndex(values.m_userIndex);
+        bChanged = true;
+    }
+    if (this->m_name != values.m_name) {
+        this->setName(values.m_name);
+        bChanged = true;
+    }
+    if (this->m_place != values.m_place) {
+        this->setPlace(values.m_place);
+        bChanged = true;
+    }
+    if (this->m_discount != values.m_discount) {
+        this->setDiscount(values.m_discount);
+        bChanged = true;
+    }
+    return bChanged;
+}
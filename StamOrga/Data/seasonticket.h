@@ -24,6 +24,15 @@
 
 #include "../../Common/General/globalfunctions.h"
 
+/* Plain values of a season ticket, so received tickets can be compared before an object is created */
+struct SeasonTicketValues {
+    quint32 m_index;
+    quint32 m_userIndex;
+    quint8  m_discount;
+    QString m_name;
+    QString m_place;
+};
+
 class SeasonTicketItem : public QObject
 {
     Q_OBJECT
@@ -78,6 +87,8 @@ public:
         }
     }
 
+    bool setValues(const SeasonTicketValues& values);
+
     Q_INVOKABLE bool isTicketYourOwn() { return this->m_ownTicket; }
     void checkTicketOwn(quint32 userIndex)
     {
@@ -0,0 +1,162 @@
+/*
+*	This file is part of StamOrga
+*   Copyright (C) 2017 Markus Schneider
+*
+*	This program is free software; you can redistribute it and/or modify
+*   it under the terms of the GNU General Public License as published by
+*   the Free Software Foundation; either version 3 of the License, or
+*   (at your option) any later version.
+*
+*	StamOrga is distributed in the hope that it will be useful,
+*    but WITHOUT ANY WARRANTY; without even the implied warranty of
+*    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+*    GNU General Public License for more details.
+
+*    You should have received a copy of the GNU General Public License
+*    along with StamOrga.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include <QtCore/QSet>
+
+#include "globaldata.h"
+#include "seasonticketmodel.h"
+
+SeasonTicketModel::SeasonTicketModel(QObject* parent)
+    : QAbstractListModel(parent)
+{
+    this->m_pGlobalData = NULL;
+}
+
+QObject* SeasonTicketModel::globalData()
+{
+    return this->m_pGlobalData;
+}
+
+void SeasonTicketModel::setGlobalData(QObject* globalData)
+{
+    GlobalData* pGlobalData = qobject_cast<GlobalData*>(globalData);
+    if (this->m_pGlobalData != pGlobalData) {
+        if (this->m_pGlobalData != NULL)
+            disconnect(this->m_pGlobalData, &GlobalData::seasonTicketListLoaded, this, &SeasonTicketModel::refresh);
+        this->m_pGlobalData = pGlobalData;
+        if (this->m_pGlobalData != NULL)
+            connect(this->m_pGlobalData, &GlobalData::seasonTicketListLoaded, this, &SeasonTicketModel::refresh);
+        emit this->globalDataChanged();
+        this->refresh();
+    }
+}
+
+int SeasonTicketModel::rowCount(const QModelIndex& parent) const
+{
+    if (parent.isValid())
+        return 0;
+    return this->m_rows.size();
+}
+
+QVariant SeasonTicketModel::data(const QModelIndex& index, int role) const
+{
+    if (!index.isValid() || index.row() >= this->m_rows.size())
+        return QVariant();
+
+    const SeasonTicketRow& row = this->m_rows.at(index.row());
+    switch (role) {
+    case TicketIndexRole:
+        return row.m_index;
+    case NameRole:
+        return row.m_name;
+    case PlaceRole:
+        return row.m_place;
+    case DiscountRole:
+        return row.m_discount;
+    case OwnTicketRole:
+        return row.m_ownTicket;
+    default:
+        return QVariant();
+    }
+}
+
+QHash<int, QByteArray> SeasonTicketModel::roleNames() const
+{
+    QHash<int, QByteArray> roles;
+    roles[TicketIndexRole] = "ticketIndex";
+    roles[NameRole]        = "name";
+    roles[PlaceRole]       = "place";
+    roles[DiscountRole]    = "discount";
+    roles[OwnTicketRole]   = "ownTicket";
+    return roles;
+}
+
+/* Same as for the games, only the differences to the last refresh are reported to the view */
+void SeasonTicketModel::refresh()
+{
+    if (this->m_pGlobalData == NULL)
+        return;
+
+    QVector<SeasonTicketRow> rows;
+    this->m_pGlobalData->getSeasonTicketRows(rows);
+
+    int oldCount = this->m_rows.size();
+
+    QSet<quint32> newIndexes;
+    foreach (const SeasonTicketRow& row, rows)
+        newIndexes.insert(row.m_index);
+
+    for (int i = this->m_rows.size() - 1; i >= 0; i--) {
+        if (!newIndexes.contains(this->m_rows[i].m_index)) {
+            this->beginRemoveRows(QModelIndex(), i, i);
+            this->m_rows.remove(i);
+            this->endRemoveRows();
+        }
+    }
+
+    QSet<quint32> oldIndexes;
+    foreach (const SeasonTicketRow& row, this->m_rows)
+        oldIndexes.insert(row.m_index);
+    int  oldPos     = 0;
+    bool bSameOrder = true;
+    foreach (const SeasonTicketRow& row, rows) {
+        if (!oldIndexes.contains(row.m_index))
+            continue;
+        if (this->m_rows[oldPos++].m_index != row.m_index) {
+            bSameOrder = false;
+            break;
+        }
+    }
+
+    if (!bSameOrder) {
+        this->beginResetModel();
+        this->m_rows = rows;
+        this->endResetModel();
+    } else {
+        for (int i = 0; i < rows.size(); i++) {
+            if (i < this->m_rows.size() && this->m_rows[i].m_index == rows[i].m_index) {
+                QVector<int> roles = this->getChangedRoles(this->m_rows[i], rows[i]);
+                if (!roles.isEmpty()) {
+                    this->m_rows[i] = rows[i];
+                    emit this->dataChanged(this->index(i), this->index(i), roles);
+                }
+            } else {
+                this->beginInsertRows(QModelIndex(), i, i);
+                this->m_rows.insert(i, rows[i]);
+                this->endInsertRows();
+            }
+        }
+    }
+
+    if (oldCount != this->m_rows.size())
+        emit this->countChanged();
+}
+
+QVector<int> SeasonTicketModel::getChangedRoles(const SeasonTicketRow& oldRow, const SeasonTicketRow& newRow)
+{
+    QVector<int> roles;
+    if (oldRow.m_name != newRow.m_name)
+        roles.append(NameRole);
+    if (oldRow.m_place != newRow.m_place)
+        roles.append(PlaceRole);
+    if (oldRow.m_discount != newRow.m_discount)
+        roles.append(DiscountRole);
+    if (oldRow.m_ownTicket != newRow.m_ownTicket)
+        roles.append(OwnTicketRole);
+    return roles;
+}
@@ -0,0 +1,74 @@
+/*
+*	This file is part of StamOrga
+*   Copyright (C) 2017 Markus Schneider
+*
+*	This program is free software; you can redistribute it and/or modify
+*   it under the terms of the GNU General Public License as published by
+*   the Free Software Foundation; either version 3 of the License, or
+*   (at your option) any later version.
+*
+*	StamOrga is distributed in the hope that it will be useful,
+*    but WITHOUT ANY WARRANTY; without even the implied warranty of
+*    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+*    GNU General Public License for more details.
+
+*    You should have received a copy of the GNU General Public License
+*    along with StamOrga.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#ifndef SEASONTICKETMODEL_H
+#define SEASONTICKETMODEL_H
+
+#include <QtCore/QAbstractListModel>
+#include <QtCore/QVector>
+
+class GlobalData;
+
+/* Copy of the values of one season ticket, taken at once for all tickets */
+struct SeasonTicketRow {
+    quint32 m_index;
+    QString m_name;
+    QString m_place;
+    quint8  m_discount;
+    bool    m_ownTicket;
+};
+
+class SeasonTicketModel : public QAbstractListModel
+{
+    Q_OBJECT
+    Q_PROPERTY(QObject* globalData READ globalData WRITE setGlobalData NOTIFY globalDataChanged)
+    Q_PROPERTY(int count READ count NOTIFY countChanged)
+public:
+    enum SeasonTicketRoles {
+        TicketIndexRole = Qt::UserRole + 1,
+        NameRole,
+        PlaceRole,
+        DiscountRole,
+        OwnTicketRole
+    };
+
+    explicit SeasonTicketModel(QObject* parent = 0);
+
+    QObject* globalData();
+    void setGlobalData(QObject* globalData);
+
+    int count() { return this->m_rows.size(); }
+
+    int rowCount(const QModelIndex& parent = QModelIndex()) const override;
+    QVariant data(const QModelIndex& index, int role = Qt::DisplayRole) const override;
+    QHash<int, QByteArray> roleNames() const override;
+
+    Q_INVOKABLE void refresh();
+
+signals:
+    void globalDataChanged();
+    void countChanged();
+
+private:
+    QVector<int> getChangedRoles(const SeasonTicketRow& oldRow, const SeasonTicketRow& newRow);
+
+    GlobalData*              m_pGlobalData;
+    QVector<SeasonTicketRow> m_rows;
+};
+
+#endif // SEASONTICKETMODEL_H
@@ -27,6 +27,14 @@
 #include "dataconnection.h"
 #include "mainconnection.h"
 
+/* States of connecting, requests are only send directly to the data connection when connected */
+enum ConnectionState {
+    CON_STATE_IDLE = 0,
+    CON_STATE_MAIN_CON,  /* waiting for the data port from the main connection */
+    CON_STATE_LOGIN,     /* waiting for the login answer of the data connection */
+    CON_STATE_CONNECTED, /* logged in */
+};
+
 
 class ConnectionHandling : public QObject
 {
@@ -55,6 +63,7 @@ public:
     qint32 startLoadMeetingInfo(const quint32 gameIndex);
     qint32 startAcceptMeetingInfo(const quint32 gameIndex, const quint32 accept,
                                   const QString name, const quint32 acceptIndex = 0);
+    qint32 startSubscribePush();
 
 
     void setGlobalData(GlobalData* pData)
@@ -90,6 +99,10 @@ private slots:
     void slMainConReqFin(qint32 result, const QString msg, const QString salt, const QString random);
 
     void slDataConLastRequestFinished(DataConRequest request);
+    void slDataConReady(const int& result);
+
+    void slDataConPushChange(quint32 type, quint32 gameIndex);
+    void slPushUpdateTimeout();
 
 private:
     BackgroundController m_ctrlMainCon;
@@ -102,10 +115,24 @@ private:
 
     qint64 m_lastSuccessTimeStamp;
 
+    ConnectionState m_conState;
+    qint64          m_conStartTimeStamp;
+    bool            m_bDataConReady;
+    quint32         m_retryGetGamesInfoCount;
+    quint32         m_retryGetTicketCount;
+
     QList<DataConRequest> m_lErrorMainCon;
+    QList<DataConRequest> m_lDataConNotReady;
+
+    QTimer m_pushUpdateTimer;
+    bool   m_bPushUpdateGames;
+    bool   m_bPushUpdateGamesInfo;
 
     void sendLoginRequest(QString password);
     void sendNewRequest(DataConRequest request);
+    void sendDataConRequest(DataConRequest request);
+    void addErrorMainConRequest(DataConRequest request);
+    void finishErrorMainConRequests(qint32 result);
 
     void checkTimeoutResult(qint32 result);
 
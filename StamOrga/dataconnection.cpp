@@ -17,11 +17,13 @@
 */
 
 #include <QtCore/QDataStream>
+#include <QtCore/QUuid>
 
 #include "../Common/General/config.h"
 #include "../Common/General/globalfunctions.h"
 #include "../Common/General/globaltiming.h"
 #include "../Common/Network/messagecommand.h"
+#include "../Common/Network/messagecompression.h"
 #include "../Common/Network/messageprotocol.h"
 #include "../Data/globalsettings.h"
 #include "dataconnection.h"
@@ -32,7 +34,16 @@ DataConnection::DataConnection(GlobalData* pData)
     this->SetWorkerName("DataConnection");
     this->m_pGlobalData        = pData;
     this->m_bRequestLoginAgain = false;
+    this->m_pushLastSequence   = 0;
     this->m_hash               = new QCryptographicHash(QCryptographicHash::Sha3_512);
+    this->m_srtt               = -1;
+    this->m_rttVar             = 0;
+    this->m_rto                = RETRANSMIT_INITIAL_RTO_MS;
+
+    /* random start, the server answers known ids from its cache and may still hold the ids of an older connection */
+    this->m_nextRequestId = QUuid::createUuid().data1;
+    if (this->m_nextRequestId == 0)
+        this->m_nextRequestId = 1;
 }
 
 
@@ -41,7 +52,6 @@ int DataConnection::DoBackgroundWork()
     /* Have to do it here or it will not be in the correct thread */
     this->m_pConTimeout = new QTimer();
     this->m_pConTimeout->setSingleShot(true);
-    this->m_pConTimeout->setInterval(SOCKET_TIMEOUT_MS);
     connect(this->m_pConTimeout, &QTimer::timeout, this, &DataConnection::slotConnectionTimeoutFired);
 
     this->m_pDataHandle = new DataHandling(this->m_pGlobalData);
@@ -96,10 +106,34 @@ void DataConnection::checkNewOncomingData()
     MessageProtocol* msg;
     while ((msg = this->m_messageBuffer.GetNextMessage()) != NULL) {
 
-        DataConRequest request = this->getActualRequest(msg->getIndex() & 0x00FFFFFF);
-        if (request.m_request == 0 && msg->getIndex() != OP_CODE_CMD_RES::ACK_NOT_LOGGED_IN)
+        if (msg->isCompressed()) {
+            MessageProtocol* plain = MessageCompression::uncompressMessage(msg);
+            if (plain == NULL) {
+                qWarning().noquote() << QString("Could not uncompress message 0x%1").arg(QString::number(msg->getIndex(), 16));
+                delete msg;
+                continue;
+            }
+            delete msg;
+            msg = plain;
+        }
+
+        if (msg->getIndex() == OP_CODE_CMD_RES::PUSH_NOTIFY_CHANGE) {
+            this->handlePushNotification(msg);
+            delete msg;
+            continue;
+        }
+
+        quint32        requestId = msg->getVersion() >= MSG_HEADER_VERSION_REQUEST_ID ? msg->getRequestId() : 0;
+        DataConRequest request   = this->getActualRequest(requestId, msg->getIndex() & 0x00FFFFFF);
+        if (request.m_request == 0 && msg->getIndex() != OP_CODE_CMD_RES::ACK_NOT_LOGGED_IN
+            && !(this->m_bRequestLoginAgain && msg->getIndex() == OP_CODE_CMD_RES::ACK_LOGIN_USER)) {
+            delete msg;
             continue;
+        }
 
+        /* Karn's algorithm, answers to retransmitted requests can not be assigned to one send */
+        if (request.m_request != 0 && request.m_retransmits == 0 && request.m_sendTime > 0)
+            this->addRoundTripSample(QDateTime::currentMSecsSinceEpoch() - request.m_sendTime);
 
         switch (msg->getIndex()) {
         case OP_CODE_CMD_RES::ACK_LOGIN_USER:
@@ -107,6 +141,8 @@ void DataConnection::checkNewOncomingData()
                 this->sendActualRequestsAgain(this->m_pDataHandle->getHandleLoginResponse(msg));
 
                 this->m_bRequestLoginAgain = false;
+                this->startNextRequestTimeout();
+                delete msg;
                 continue;
             } else {
                 request.m_result = this->m_pDataHandle->getHandleLoginResponse(msg);
@@ -196,7 +232,7 @@ void DataConnection::checkNewOncomingData()
             break;
 
         case OP_CODE_CMD_RES::ACK_GET_AVAILABLE_TICKETS:
-            request.m_result = this->m_pDataHandle->getHandleAvailableTicketListResponse(msg, request.m_lData.at(0).toUInt());
+            request.m_result = this->m_pDataHandle->getHandleAvailableTicketListResponse(msg, request.m_index);
             break;
 
         case OP_CODE_CMD_RES::ACK_CHANGE_GAME:
@@ -215,18 +251,90 @@ void DataConnection::checkNewOncomingData()
             request.m_result = msg->getIntData();
             break;
 
+        case OP_CODE_CMD_RES::ACK_SUBSCRIBE_PUSH:
+            request.m_result = this->handleSubscribePushResponse(msg);
+            break;
+
         default:
             delete msg;
             continue;
         }
         emit this->notifyLastRequestFinished(request);
-        this->removeActualRequest(request.m_request);
-        if (this->m_lActualRequest.size() == 0)
-            this->m_pConTimeout->stop();
+        this->removeActualRequest(request.m_requestId);
+        this->startNextRequestTimeout();
         delete msg;
     }
 }
 
+/* push
+ * 0   quint32     sequence        4
+ * 4   quint32     type            4   // PushNotifyType
+ * 8   quint32     gameIndex       4
+ */
+void DataConnection::handlePushNotification(MessageProtocol* msg)
+{
+    if (msg->getDataLength() != 12)
+        return;
+
+    const char* pData = msg->getPointerToData();
+    quint32     sequence, type, gameIndex;
+    memcpy(&sequence, pData, sizeof(quint32));
+    memcpy(&type, pData + 4, sizeof(quint32));
+    memcpy(&gameIndex, pData + 8, sizeof(quint32));
+    sequence  = qFromLittleEndian(sequence);
+    type      = qFromLittleEndian(type);
+    gameIndex = qFromLittleEndian(gameIndex);
+
+    /* Acknowledge every time, the first acknowledge could have been lost */
+    MessageProtocol ack(OP_CODE_CMD_REQ::REQ_ACK_PUSH, sequence);
+    this->m_pDataUdpSocket->writeDatagram(ack.getNetworkProtocol(), ack.getNetworkSize(),
+                                          this->m_hDataReceiver, this->m_pGlobalData->conDataPort());
+    this->m_pGlobalData->setPushLastContact(QDateTime::currentMSecsSinceEpoch());
+
+    if (sequence <= this->m_pushLastSequence)
+        return; // already received
+
+    if (sequence != this->m_pushLastSequence + 1) {
+        qInfo().noquote() << QString("Missed push notifications %1 to %2, updating everything")
+                                 .arg(this->m_pushLastSequence + 1)
+                                 .arg(sequence - 1);
+        type      = PUSH_GAME_CHANGED;
+        gameIndex = 0;
+    }
+    this->m_pushLastSequence = sequence;
+
+    emit this->notifyPushChange(type, gameIndex);
+}
+
+qint32 DataConnection::handleSubscribePushResponse(MessageProtocol* msg)
+{
+    if (msg->getDataLength() == 4)
+        return msg->getIntData();
+    if (msg->getDataLength() != 8)
+        return ERROR_CODE_WRONG_SIZE;
+
+    const char* pData = msg->getPointerToData();
+    qint32      result;
+    quint32     sequence;
+    memcpy(&result, pData, sizeof(qint32));
+    memcpy(&sequence, pData + 4, sizeof(quint32));
+    result   = qFromLittleEndian(result);
+    sequence = qFromLittleEndian(sequence);
+    if (result != ERROR_CODE_SUCCESS)
+        return result;
+
+    if (sequence != this->m_pushLastSequence) {
+        qInfo().noquote() << QString("Push sequence differs %1 != %2, updating everything")
+                                 .arg(sequence)
+                                 .arg(this->m_pushLastSequence);
+        this->m_pushLastSequence = sequence;
+        emit this->notifyPushChange(PUSH_GAME_CHANGED, 0);
+    }
+    this->m_pGlobalData->setPushActive(true);
+
+    return result;
+}
+
 void DataConnection::startSendLoginRequest(DataConRequest request)
 {
     QString passWord = request.m_lData.at(0);
@@ -329,55 +437,6 @@ void DataConnection::startSendGamesInfoListRequest(DataConRequest request)
     this->sendMessageRequest(&msg, request);
 }
 
-void DataConnection::startSendSetGameTimeFixedRequest(DataConRequest request)
-{
-    quint32 data[2];
-    data[0] = request.m_lData.at(0).toUInt();
-    data[1] = request.m_lData.at(1).toUInt();
-    MessageProtocol msg(request.m_request, (char*)&data[0], 8);
-    this->sendMessageRequest(&msg, request);
-}
-
-void DataConnection::startSendAddSeasonTicket(DataConRequest request)
-{
-    QString     name = request.m_lData.at(1);
-    QByteArray  seasonTicket;
-    QDataStream wSeasonTicket(&seasonTicket, QIODevice::WriteOnly);
-    wSeasonTicket.setByteOrder(QDataStream::LittleEndian);
-    wSeasonTicket << request.m_lData.at(0).toUInt();
-    wSeasonTicket << quint16(name.toUtf8().size());
-    seasonTicket.append(name);
-
-    MessageProtocol msg(request.m_request, seasonTicket);
-    this->sendMessageRequest(&msg, request);
-}
-
-void DataConnection::startSendRemoveSeasonTicket(DataConRequest request)
-{
-    quint32         index = request.m_lData.at(0).toUInt();
-    MessageProtocol msg(request.m_request, index);
-    this->sendMessageRequest(&msg, request);
-}
-
-void DataConnection::startSendEditSeasonTicket(DataConRequest request)
-{
-    quint32    index    = qToLittleEndian(request.m_lData.at(0).toUInt());
-    QByteArray name     = request.m_lData.at(1).toUtf8();
-    QByteArray place    = request.m_lData.at(2).toUtf8();
-    quint32    discount = qToLittleEndian(request.m_lData.at(3).toUInt());
-    char       data[200];
-    memset(&data[0], 0x0, 200);
-    memcpy(&data[0], &index, sizeof(quint32));
-    memcpy(&data[4], &discount, sizeof(quint32));
-    memcpy(&data[8], name.constData(), name.length());
-    memcpy(&data[9 + name.length()], place.constData(), place.length());
-
-    quint32 size = 8 + name.length() + place.length() + 2;
-
-    MessageProtocol msg(request.m_request, &data[0], size);
-    this->sendMessageRequest(&msg, request);
-}
-
 void DataConnection::startSendSeasonTicketListRequest(DataConRequest request)
 {
     quint32 data[2];
@@ -389,93 +448,73 @@ void DataConnection::startSendSeasonTicketListRequest(DataConRequest request)
     this->sendMessageRequest(&msg, request);
 }
 
-void DataConnection::startSendChangeTicketState(DataConRequest request)
-{
-    QByteArray  seasonTicket;
-    QString     name = request.m_lData.at(3);
-    QDataStream wSeasonTicket(&seasonTicket, QIODevice::WriteOnly);
-    wSeasonTicket.setByteOrder(QDataStream::LittleEndian);
-    wSeasonTicket << request.m_lData.at(0).toUInt(); /* ticketIndex */
-    wSeasonTicket << request.m_lData.at(1).toUInt(); /* game Index */
-    wSeasonTicket << request.m_lData.at(2).toUInt(); /* state */
-    wSeasonTicket << quint16(name.toUtf8().size());
-    seasonTicket.append(name);
-
-    MessageProtocol msg(request.m_request, seasonTicket);
-    this->sendMessageRequest(&msg, request);
-}
-
 void DataConnection::startSendAvailableTicketListRequest(DataConRequest request)
 {
     quint32 data[3];
     qint64  timeStamp = qToLittleEndian(this->m_pGlobalData->getSeasonTicketLastServerUpdate());
 
-    data[0] = request.m_lData.at(0).toUInt();
+    data[0] = qToLittleEndian(request.m_index);
     memcpy(&data[1], &timeStamp, sizeof(qint64));
 
     MessageProtocol msg(request.m_request, (char*)(&data[0]), sizeof(quint32) * 3);
     this->sendMessageRequest(&msg, request);
 }
 
-void DataConnection::startSendChangeGameRequest(DataConRequest request)
+void DataConnection::startSendSubscribePush(DataConRequest request)
 {
-    QByteArray data;
-    data.append(request.m_lData.at(0));
-    data.append(char(0x00));
-
-    MessageProtocol msg(request.m_request, data);
+    MessageProtocol msg(request.m_request, this->m_pushLastSequence);
     this->sendMessageRequest(&msg, request);
 }
 
-void DataConnection::startSendChangeMeetingInfo(DataConRequest request)
+/* Parameters were already encoded by the caller, see DataConRequest */
+void DataConnection::startSendPayloadRequest(DataConRequest request)
 {
-    QByteArray  data;
-    QDataStream wData(&data, QIODevice::WriteOnly);
-    wData.setByteOrder(QDataStream::LittleEndian);
-    wData << request.m_lData.at(0).toUInt(); /* game Index */
-    data.append(request.m_lData.at(1));      /* when */
-    data.append(char(0x00));
-    data.append(request.m_lData.at(2)); /* where */
-    data.append(char(0x00));
-    data.append(request.m_lData.at(3)); /* info */
-    data.append(char(0x00));
-
-    MessageProtocol msg(request.m_request, data);
+    MessageProtocol msg(request.m_request, request.m_payload);
     this->sendMessageRequest(&msg, request);
 }
 
-void DataConnection::startSendGetMeetingInfo(DataConRequest request)
+void DataConnection::slotConnectionTimeoutFired()
 {
-    quint32 data;
-    data = qToLittleEndian(request.m_lData.at(0).toUInt()); /* game Index */
+    qint64 now       = QDateTime::currentMSecsSinceEpoch();
+    bool   bTimedOut = false;
+    for (int i = 0; i < this->m_lActualRequest.size(); i++) {
+        DataConRequest& request = this->m_lActualRequest[i];
+        if (request.m_timeout <= now) {
+            qInfo().noquote() << QString("DataConnection: Timeout from Data UdpServer for request 0x%1 with id %2")
+                                     .arg(QString::number(request.m_request, 16))
+                                     .arg(request.m_requestId);
+            bTimedOut = true;
+            continue;
+        }
 
-    MessageProtocol msg(request.m_request, data);
-    this->sendMessageRequest(&msg, request);
-}
+        /* While logging in again the requests are send again after the login anyway */
+        if (request.m_nextRetransmit > now || this->m_bRequestLoginAgain)
+            continue;
 
+        if (request.m_retransmits >= RETRANSMIT_MAX_RETRIES) {
+            request.m_nextRetransmit = request.m_timeout;
+            continue;
+        }
 
-#define BUFFER_SIZE 1000
-void DataConnection::startSendAcceptMeeting(DataConRequest request)
-{
-    quint32 data[BUFFER_SIZE / sizeof(quint32)];
-    data[0] = qToLittleEndian(request.m_lData.at(0).toUInt()); /* game Index */
-    data[1] = qToLittleEndian(request.m_lData.at(1).toUInt()); /* accept */
-    data[2] = qToLittleEndian(request.m_lData.at(2).toUInt()); /* acceptIndex */
-
-    QByteArray tmp = request.m_lData.at(3).toUtf8();
-    if (tmp.size() > (BUFFER_SIZE - 12))
-        tmp.resize(BUFFER_SIZE - 12);
-    char* pName = (char*)&data[3];
-    memcpy(pName, tmp.constData(), tmp.size());
-    pName[tmp.size()] = 0x00;
-
-    MessageProtocol msg(request.m_request, (char*)(&data[0]), 16 + tmp.size());
-    this->sendMessageRequest(&msg, request);
-}
+        /* Same id as before, the server answers it from its cache when it already handled it. The
+         * answer is send complete again, so a part of it still in the buffer has to be dropped. */
+        this->m_messageBuffer.Reset();
+        request.m_retransmits++;
+        request.m_nextRetransmit = now + this->getRetransmitTimeout(request.m_retransmits);
+        qInfo().noquote() << QString("DataConnection: Retransmit %1 of request 0x%2 with id %3, rto %4ms")
+                                 .arg(request.m_retransmits)
+                                 .arg(QString::number(request.m_request, 16))
+                                 .arg(request.m_requestId)
+                                 .arg(this->m_rto);
+        this->sendNetworkData(request.m_sentData.constData(), request.m_sentData.size());
+    }
 
-void DataConnection::slotConnectionTimeoutFired()
-{
-    qInfo().noquote() << "DataConnection: Timeout from Data UdpServer";
+    if (!bTimedOut) {
+        this->startNextRequestTimeout();
+        return;
+    }
+
+    /* The data connection is restarted after a timeout, so all other requests are lost too */
     while (this->m_lActualRequest.size() > 0) {
         DataConRequest request = this->m_lActualRequest.last();
         request.m_result       = ERROR_CODE_TIMEOUT;
@@ -490,72 +529,150 @@ qint32 DataConnection::sendMessageRequest(MessageProtocol* msg, DataConRequest r
     if (this->m_pDataUdpSocket == NULL)
         return -1;
 
-    quint32     sendBytes       = 0;
-    quint32     totalPacketSize = msg->getNetworkSize();
-    const char* pData           = msg->getNetworkProtocol();
+    if (request.m_requestId == 0) {
+        request.m_requestId = this->m_nextRequestId++;
+        if (this->m_nextRequestId == 0)
+            this->m_nextRequestId = 1;
+    }
+    msg->setRequestId(request.m_requestId);
+
+    qint64 rValue = this->sendNetworkData(msg->getNetworkProtocol(), msg->getNetworkSize());
+    if (rValue < 0) {
+        request.m_result = ERROR_CODE_ERR_SEND;
+        emit this->notifyLastRequestFinished(request);
+
+        return rValue;
+    }
+
+    qint64 now               = QDateTime::currentMSecsSinceEpoch();
+    request.m_timeout        = now + SOCKET_TIMEOUT_MS;
+    request.m_sentData       = QByteArray(msg->getNetworkProtocol(), msg->getNetworkSize());
+    request.m_sendTime       = now;
+    request.m_nextRetransmit = now + this->m_rto;
+    request.m_retransmits    = 0;
+
+    /* Requests send again keep their id, only refresh the timeout */
+    bool bFound = false;
+    for (int i = 0; i < this->m_lActualRequest.size(); i++) {
+        if (this->m_lActualRequest[i].m_requestId == request.m_requestId) {
+            this->m_lActualRequest[i].m_timeout        = request.m_timeout;
+            this->m_lActualRequest[i].m_sentData       = request.m_sentData;
+            this->m_lActualRequest[i].m_sendTime       = request.m_sendTime;
+            this->m_lActualRequest[i].m_nextRetransmit = request.m_nextRetransmit;
+            this->m_lActualRequest[i].m_retransmits    = request.m_retransmits;
+            bFound                                     = true;
+            break;
+        }
+    }
+
+    /* Only add when not sending request again */
+    if (!bFound && !this->m_bRequestLoginAgain) {
+        this->m_lActualRequest.append(request);
+    }
+    this->startNextRequestTimeout();
+
+    return rValue;
+}
 
+/*
+ * Send data in datagrams of MAX_DATAGRAMM_SIZE to the data server, returns the send bytes or < 0 on error
+ */
+qint64 DataConnection::sendNetworkData(const char* pData, quint32 size)
+{
+    quint32 sendBytes = 0;
     do {
         quint32 currentSendSize;
-        if ((totalPacketSize - sendBytes) > MAX_DATAGRAMM_SIZE)
+        if ((size - sendBytes) > MAX_DATAGRAMM_SIZE)
             currentSendSize = MAX_DATAGRAMM_SIZE;
         else
-            currentSendSize = totalPacketSize - sendBytes;
+            currentSendSize = size - sendBytes;
 
         qint64 rValue = this->m_pDataUdpSocket->writeDatagram(pData + sendBytes,
                                                               currentSendSize,
                                                               this->m_hDataReceiver,
                                                               this->m_pGlobalData->conDataPort());
-        if (rValue < 0) {
-            request.m_result = ERROR_CODE_ERR_SEND;
-            emit this->notifyLastRequestFinished(request);
-
+        if (rValue < 0)
             return rValue;
-        }
         sendBytes += rValue;
-        //                QThread::msleep(25);
-    } while (sendBytes < totalPacketSize);
+    } while (sendBytes < size);
 
-    this->m_pConTimeout->start();
+    return sendBytes;
+}
 
-    /* Only add when not sending request again */
-    if (!this->m_bRequestLoginAgain) {
-        this->m_lActualRequest.append(request);
+/*
+ * Smoothed round trip time and retransmission timeout like RFC 6298,
+ * RTTVAR = 3/4 RTTVAR + 1/4 |SRTT - R|, SRTT = 7/8 SRTT + 1/8 R, RTO = SRTT + 4 RTTVAR
+ */
+void DataConnection::addRoundTripSample(qint64 rtt)
+{
+    if (rtt < 0)
+        return;
+
+    if (this->m_srtt < 0) {
+        this->m_srtt   = rtt;
+        this->m_rttVar = rtt / 2;
+    } else {
+        this->m_rttVar = (3 * this->m_rttVar + qAbs(this->m_srtt - rtt)) / 4;
+        this->m_srtt   = (7 * this->m_srtt + rtt) / 8;
     }
+    this->m_rto = qBound(RETRANSMIT_MIN_RTO_MS, this->m_srtt + 4 * this->m_rttVar, RETRANSMIT_MAX_RTO_MS);
+}
 
-    return sendBytes;
+/*
+ * Exponential backoff, the timeout doubles with every retransmission
+ */
+qint64 DataConnection::getRetransmitTimeout(quint32 retransmits)
+{
+    qint64 rto = this->m_rto;
+    for (quint32 i = 0; i < retransmits && rto < RETRANSMIT_MAX_RTO_MS; i++)
+        rto *= 2;
+    return qMin(rto, RETRANSMIT_MAX_RTO_MS);
 }
 
-void DataConnection::removeActualRequest(quint32 req)
+void DataConnection::removeActualRequest(quint32 requestId)
 {
     for (int i = 0; i < this->m_lActualRequest.size(); i++) {
-        if (this->m_lActualRequest[i].m_request == req) {
-            //            if (this->m_lActualRequest[i].m_lData != NULL)
-            //                delete this->m_lActualRequest[i].m_lData;
+        if (this->m_lActualRequest[i].m_requestId == requestId) {
             this->m_lActualRequest.removeAt(i);
+            return;
         }
     }
 }
 
-
-DataConRequest DataConnection::getActualRequest(quint32 req)
+/*
+ * Answers from servers before MSG_HEADER_VERSION_REQUEST_ID do not return the id (requestId = 0),
+ * take the first with the same command
+ */
+DataConRequest DataConnection::getActualRequest(quint32 requestId, quint32 req)
 {
     for (int i = 0; i < this->m_lActualRequest.size(); i++) {
-        if (this->m_lActualRequest[i].m_request == req) {
+        if (this->m_lActualRequest[i].m_request != req)
+            continue;
+        if (requestId == 0 || this->m_lActualRequest[i].m_requestId == requestId)
             return this->m_lActualRequest[i];
-        }
     }
     return DataConRequest(0);
 }
 
-QString DataConnection::getActualRequestData(quint32 req, qint32 index)
+void DataConnection::startNextRequestTimeout()
 {
+    if (this->m_lActualRequest.size() == 0) {
+        this->m_pConTimeout->stop();
+        return;
+    }
+
+    qint64 nextTimeout = this->m_lActualRequest[0].m_timeout;
     for (int i = 0; i < this->m_lActualRequest.size(); i++) {
-        if (this->m_lActualRequest[i].m_request == req) {
-            if (this->m_lActualRequest[i].m_lData.size() > index)
-                return this->m_lActualRequest[i].m_lData.at(index);
-        }
+        if (this->m_lActualRequest[i].m_timeout < nextTimeout)
+            nextTimeout = this->m_lActualRequest[i].m_timeout;
+        if (this->m_bRequestLoginAgain || this->m_lActualRequest[i].m_nextRetransmit == 0)
+            continue;
+        if (this->m_lActualRequest[i].m_nextRetransmit < nextTimeout)
+            nextTimeout = this->m_lActualRequest[i].m_nextRetransmit;
     }
-    return NULL;
+
+    qint64 diff = nextTimeout - QDateTime::currentMSecsSinceEpoch();
+    this->m_pConTimeout->start(diff > 0 ? int(diff) : 0);
 }
 
 void DataConnection::sendActualRequestsAgain(qint32 result)
@@ -608,50 +725,29 @@ void DataConnection::startSendNewRequest(DataConRequest request)
         this->startSendGamesInfoListRequest(request);
         break;
 
-    case OP_CODE_CMD_REQ::REQ_SET_FIXED_GAME_TIME:
-        this->startSendSetGameTimeFixedRequest(request);
-        break;
-
-    case OP_CODE_CMD_REQ::REQ_ADD_TICKET:
-        if (request.m_lData.size() > 1)
-            this->startSendAddSeasonTicket(request);
-        break;
-
-    case OP_CODE_CMD_REQ::REQ_REMOVE_TICKET:
-        if (request.m_lData.size() > 0)
-            this->startSendRemoveSeasonTicket(request);
-        break;
-
     case OP_CODE_CMD_REQ::REQ_GET_TICKETS_LIST:
         this->startSendSeasonTicketListRequest(request);
         break;
 
-    case OP_CODE_CMD_REQ::REQ_CHANGE_TICKET:
-        this->startSendEditSeasonTicket(request);
-        break;
-
-    case OP_CODE_CMD_REQ::REQ_STATE_CHANGE_SEASON_TICKET:
-        this->startSendChangeTicketState(request);
-        break;
-
     case OP_CODE_CMD_REQ::REQ_GET_AVAILABLE_TICKETS:
         this->startSendAvailableTicketListRequest(request);
         break;
 
+    case OP_CODE_CMD_REQ::REQ_SET_FIXED_GAME_TIME:
+    case OP_CODE_CMD_REQ::REQ_ADD_TICKET:
+    case OP_CODE_CMD_REQ::REQ_REMOVE_TICKET:
+    case OP_CODE_CMD_REQ::REQ_CHANGE_TICKET:
+    case OP_CODE_CMD_REQ::REQ_STATE_CHANGE_SEASON_TICKET:
     case OP_CODE_CMD_REQ::REQ_CHANGE_GAME:
-        this->startSendChangeGameRequest(request);
-        break;
-
     case OP_CODE_CMD_REQ::REQ_CHANGE_MEETING_INFO:
-        this->startSendChangeMeetingInfo(request);
-        break;
-
     case OP_CODE_CMD_REQ::REQ_GET_MEETING_INFO:
-        this->startSendGetMeetingInfo(request);
+    case OP_CODE_CMD_REQ::REQ_ACCEPT_MEETING:
+        if (request.m_payload.size() > 0)
+            this->startSendPayloadRequest(request);
         break;
 
-    case OP_CODE_CMD_REQ::REQ_ACCEPT_MEETING:
-        this->startSendAcceptMeeting(request);
+    case OP_CODE_CMD_REQ::REQ_SUBSCRIBE_PUSH:
+        this->startSendSubscribePush(request);
         break;
 
     default:
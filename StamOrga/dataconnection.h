@@ -22,6 +22,7 @@
 #include <QtCore/QCryptographicHash>
 #include <QtCore/QList>
 #include <QtCore/QTimer>
+#include <QtCore/QtEndian>
 #include <QtNetwork/QUdpSocket>
 
 #include "../Common/General/backgroundworker.h"
@@ -29,17 +30,69 @@
 #include "../Data/globaldata.h"
 #include "datahandling.h"
 
+/*
+ * The parameters of a request are written typed into m_payload in the network format of the
+ * opcode, the data connection sends them without converting them again. m_lData is only used
+ * for the strings which are hashed in the data connection thread (login, password, name).
+ */
 struct DataConRequest {
     quint32        m_request;
     QList<QString> m_lData;
+    QByteArray     m_payload;
+    quint32        m_index;
     qint32         m_result;
     QString        m_returnData;
+    quint32        m_requestId;
+    qint64         m_timeout;
+    QByteArray     m_sentData;       /* message as it was sent, for retransmissions */
+    qint64         m_sendTime;       /* time of the first send, for the round trip time */
+    qint64         m_nextRetransmit;
+    quint32        m_retransmits;
 
     DataConRequest(quint32 req)
     {
-        m_request = req;
+        m_request        = req;
+        m_index          = 0;
+        m_requestId      = 0;
+        m_timeout        = 0;
+        m_sendTime       = 0;
+        m_nextRetransmit = 0;
+        m_retransmits    = 0;
+    }
+    DataConRequest()
+    {
+        m_request        = 0;
+        m_index          = 0;
+        m_requestId      = 0;
+        m_timeout        = 0;
+        m_sendTime       = 0;
+        m_nextRetransmit = 0;
+        m_retransmits    = 0;
+    }
+
+    void appendUInt32(quint32 value)
+    {
+        value = qToLittleEndian(value);
+        m_payload.append((const char*)&value, sizeof(quint32));
+    }
+    void appendUInt16(quint16 value)
+    {
+        value = qToLittleEndian(value);
+        m_payload.append((const char*)&value, sizeof(quint16));
+    }
+    /* zero terminated utf8 string */
+    void appendString(const QString& value)
+    {
+        m_payload.append(value.toUtf8());
+        m_payload.append(char(0x00));
+    }
+    /* utf8 string with leading quint16 size */
+    void appendSizedString(const QString& value)
+    {
+        QByteArray utf8 = value.toUtf8();
+        appendUInt16(quint16(utf8.size()));
+        m_payload.append(utf8);
     }
-    DataConRequest() {}
 };
 
 class DataConnection : public BackgroundWorker
@@ -58,6 +111,7 @@ public:
 
 signals:
     void notifyLastRequestFinished(DataConRequest request);
+    void notifyPushChange(quint32 type, quint32 gameIndex);
 
 public slots:
     void startSendNewRequest(DataConRequest request);
@@ -84,31 +138,37 @@ private:
     void startSendReadableNameRequest(DataConRequest request);
     void startSendGamesListRequest(DataConRequest request);
     void startSendGamesInfoListRequest(DataConRequest request);
-    void startSendSetGameTimeFixedRequest(DataConRequest request);
-    void startSendAddSeasonTicket(DataConRequest request);
-    void startSendRemoveSeasonTicket(DataConRequest request);
     void startSendSeasonTicketListRequest(DataConRequest request);
-    void startSendEditSeasonTicket(DataConRequest request);
-    void startSendChangeTicketState(DataConRequest request);
     void startSendAvailableTicketListRequest(DataConRequest request);
-    void startSendChangeGameRequest(DataConRequest request);
-    void startSendChangeMeetingInfo(DataConRequest request);
-    void startSendGetMeetingInfo(DataConRequest request);
-    void startSendAcceptMeeting(DataConRequest request);
+    void startSendSubscribePush(DataConRequest request);
+    void startSendPayloadRequest(DataConRequest request);
 
 
     void   checkNewOncomingData();
+    void   handlePushNotification(MessageProtocol* msg);
+    qint32 handleSubscribePushResponse(MessageProtocol* msg);
     qint32 sendMessageRequest(MessageProtocol* msg, DataConRequest request);
-    void removeActualRequest(quint32 req);
-    DataConRequest getActualRequest(quint32 req);
-    QString getActualRequestData(quint32 req, qint32 index);
+    qint64 sendNetworkData(const char* pData, quint32 size);
+    void removeActualRequest(quint32 requestId);
+    DataConRequest getActualRequest(quint32 requestId, quint32 req);
+    void startNextRequestTimeout();
     QString createHashValue(const QString first, const QString second);
 
     bool m_bRequestLoginAgain;
     void sendActualRequestsAgain(qint32 result);
 
     QList<DataConRequest> m_lActualRequest;
+    quint32               m_pushLastSequence;
+    quint32               m_nextRequestId;
     QCryptographicHash*   m_hash;
+
+    /* round trip time estimation like RFC 6298, all in ms */
+    qint64 m_srtt;
+    qint64 m_rttVar;
+    qint64 m_rto;
+
+    void   addRoundTripSample(qint64 rtt);
+    qint64 getRetransmitTimeout(quint32 retransmits);
 };
 
 #endif // DATACONNECTION_H
@@ -16,6 +16,8 @@
 *    along with StamOrga.  If not, see <http://www.gnu.org/licenses/>.
 */
 
+#include <QtCore/QElapsedTimer>
+#include <QtCore/QSet>
 #include <QtCore/QtEndian>
 #include <QtQml/QQmlEngine>
 
@@ -114,6 +116,18 @@ qint32 DataHandling::getHandleUserPropsResponse(MessageProtocol* msg)
     return rValue;
 }
 
+/* Returns the next field of a record split by ';', read directly from the message data */
+static QString readNextField(const char*& pField, const char* pEnd)
+{
+    const char* pSep = (const char*)memchr(pField, ';', pEnd - pField);
+    if (pSep == NULL)
+        pSep = pEnd;
+
+    QString field = QString::fromUtf8(pField, int(pSep - pField));
+    pField        = pSep < pEnd ? pSep + 1 : pEnd;
+    return field;
+}
+
 #define GAMES_OFFSET (1 + 1 + 8 + 4)
 
 qint32 DataHandling::getHandleGamesListResponse(MessageProtocol* msg)
@@ -122,74 +136,62 @@ qint32 DataHandling::getHandleGamesListResponse(MessageProtocol* msg)
         return ERROR_CODE_WRONG_SIZE;
 
     const char* pData  = msg->getPointerToData();
-    qint32      rValue = qFromLittleEndian(*((qint32*)pData));
+    qint32      rValue = qFromLittleEndian<qint32>((const uchar*)pData);
 
     if (rValue != ERROR_CODE_SUCCESS)
         return rValue;
 
+    QElapsedTimer decodeTimer;
+    decodeTimer.start();
+
     quint32 totalSize = msg->getDataLength();
     quint32 offset    = 4;
 
-    qint16 updateIndex;
-    memcpy(&updateIndex, pData + offset, sizeof(qint16));
-    updateIndex = qFromLittleEndian(updateIndex);
+    qint16 updateIndex = qFromLittleEndian<qint16>((const uchar*)(pData + offset));
     offset += sizeof(qint16);
 
-    quint16 size;
-    quint8  tmp;
-    qint64  timeStamp;
+    /* The records are read in place, a game is only created by the global data when it is new.
+     * The loads go through byte pointers, reading from unaligned qint64 pointers gave SIGBUS on Android */
+    GamePlayValues values;
+    quint32        count = 0;
     this->m_pGlobalData->startUpdateGamesPlay(updateIndex);
     while (offset + GAMES_OFFSET < totalSize) {
-        GamePlay* play = new GamePlay();
-        memcpy(&size, pData + offset, sizeof(quint16));
-        size = qFromLittleEndian(size);
+        quint16 size = qFromLittleEndian<quint16>((const uchar*)(pData + offset));
         offset += sizeof(quint16);
 
-        if (size <= GAMES_OFFSET) {
-            qWarning().noquote() << QString("Size is to small %1").arg(size);
-            delete play;
-            break;
+        /* A broken list is not taken, the games not read yet would be removed */
+        if (size <= GAMES_OFFSET || offset + size > totalSize) {
+            qWarning().noquote() << QString("Size is wrong %1").arg(size);
+            return ERROR_CODE_WRONG_SIZE;
         }
-        memcpy(&tmp, pData + offset, sizeof(quint8));
-        play->setSeasonIndex(qFromLittleEndian(tmp));
-        offset += sizeof(quint8);
-        memcpy(&tmp, pData + offset, sizeof(quint8));
-        tmp = qFromLittleEndian(tmp);
-        play->setCompetition(CompetitionIndex(tmp & 0x7F));
-        play->setTimeFixed((tmp & 0x80) > 0 ? true : false);
-        offset += 1;
-
-        /* On Android there are problems reading from qint64 pointers???? SIGBUS*/
-        //        play->setTimeStamp(qFromLittleEndian(*(qint64 *)(pData + offset)));
-        quint32 tmp32 = qFromLittleEndian(*(qint32*)(pData + offset));
-        timeStamp     = qint64(tmp32);
-        tmp32         = qFromLittleEndian(*(quint32*)(pData + offset + 4));
-        timeStamp |= qint64(tmp32) << 32;
-
-        play->setTimeStamp(timeStamp);
-        offset += 8;
-
-        play->setIndex(qFromLittleEndian(*(quint32*)(pData + offset)));
-        offset += 4;
-
-        QString playString(QByteArray(pData + offset, size - GAMES_OFFSET));
-        offset += (size - GAMES_OFFSET);
-        QStringList lplayString = playString.split(";");
-
-        if (lplayString.size() > 0)
-            play->setHome(lplayString.value(0));
-        if (lplayString.size() > 1)
-            play->setAway(lplayString.value(1));
-        if (lplayString.size() > 2)
-            play->setScore(lplayString.value(2));
 
-        QQmlEngine::setObjectOwnership(play, QQmlEngine::CppOwnership);
-        this->m_pGlobalData->addNewGamePlay(play, updateIndex);
+        const uchar* pRecord = (const uchar*)(pData + offset);
+        values.m_seasonIndex = pRecord[0];
+        values.m_competition = CompetitionIndex(pRecord[1] & 0x7F);
+        values.m_timeFixed   = (pRecord[1] & 0x80) > 0 ? true : false;
+        values.m_timestamp   = qFromLittleEndian<qint64>(pRecord + 2);
+        values.m_index       = qFromLittleEndian<quint32>(pRecord + 10);
+
+        const char* pField = pData + offset + GAMES_OFFSET;
+        const char* pEnd   = pData + offset + size;
+        values.m_home      = readNextField(pField, pEnd);
+        values.m_away      = readNextField(pField, pEnd);
+        values.m_score     = readNextField(pField, pEnd);
+        offset += size;
+
+        this->m_pGlobalData->addNewGamePlay(values, updateIndex);
+        count++;
     }
-    memcpy(&timeStamp, pData + offset, sizeof(qint64));
+    if (offset + sizeof(qint64) > totalSize)
+        return ERROR_CODE_WRONG_SIZE;
+    this->m_pGlobalData->finishUpdateGamesPlay();
+
+    qint64 timeStamp = qFromLittleEndian<qint64>((const uchar*)(pData + offset));
     offset += sizeof(qint64);
 
-    this->m_pGlobalData->saveCurrentGamesList(qFromLittleEndian(timeStamp));
+    qDebug().noquote() << QString("Decoded %1 games in %2 us").arg(count).arg(decodeTimer.nsecsElapsed() / 1000);
+
+    this->m_pGlobalData->saveCurrentGamesList(timeStamp);
 
     return rValue;
 }
@@ -215,22 +217,8 @@ qint32 DataHandling::getHandleGamesInfoListResponse(MessageProtocol* msg)
     gameSize = qFromLittleEndian(gameSize);
     readInfo = qFromLittleEndian(readInfo);
 
-    if ((readInfo & 0x1) == 0x0) {
-        quint32 numbOfGames = this->m_pGlobalData->getGamePlayLength();
-        for (quint32 i = 0; i < numbOfGames; i++) {
-            GamePlay* play = this->m_pGlobalData->getGamePlayFromArrayIndex(i);
-            if (play == NULL)
-                continue;
-            play->setFreeTickets(0);
-            play->setBlockedTickets(0);
-            play->setReservedTickets(0);
-            play->setAcceptedMeetingCount(0);
-            play->setInterestedMeetingCount(0);
-            play->setDeclinedMeetingCount(0);
-        }
-    }
-
-    quint32 totalSize = msg->getDataLength();
+    QSet<quint32> updatedGames;
+    quint32       totalSize = msg->getDataLength();
     quint32 gameIndex;
     quint16 freeTicks, reservTicks, blockTicks;
     quint16 acceptMeet, interestMeet, declineMeet, meetInfo;
@@ -245,6 +233,7 @@ qint32 DataHandling::getHandleGamesInfoListResponse(MessageProtocol* msg)
             continue;
         }
         offset += sizeof(quint32);
+        updatedGames.insert(gameIndex);
 
         memcpy(&freeTicks, pData + offset, sizeof(quint16));
         freeTicks = qFromLittleEndian(freeTicks);
@@ -285,6 +274,23 @@ qint32 DataHandling::getHandleGamesInfoListResponse(MessageProtocol* msg)
         play->setMeetingInfo(meetInfo);
     }
 
+    /* the complete list only contains games with infos, reset the other ones, the values of the
+     * sent games are set only once so the views do not see them going to zero in between */
+    if ((readInfo & 0x1) == 0x0) {
+        quint32 numbOfGames = this->m_pGlobalData->getGamePlayLength();
+        for (quint32 i = 0; i < numbOfGames; i++) {
+            GamePlay* play = this->m_pGlobalData->getGamePlayFromArrayIndex(i);
+            if (play == NULL || updatedGames.contains(play->index()))
+                continue;
+            play->setFreeTickets(0);
+            play->setBlockedTickets(0);
+            play->setReservedTickets(0);
+            play->setAcceptedMeetingCount(0);
+            play->setInterestedMeetingCount(0);
+            play->setDeclinedMeetingCount(0);
+        }
+    }
+
     return rValue;
 }
 
@@ -295,8 +301,7 @@ qint32 DataHandling::getHandleSeasonTicketListResponse(MessageProtocol* msg)
     if (msg->getDataLength() < 6)
         return ERROR_CODE_WRONG_SIZE;
 
-    quint32     userIndex = this->m_pGlobalData->userIndex();
-    const char* pData     = msg->getPointerToData();
+    const char* pData = msg->getPointerToData();
     qint32      rValue;
     memcpy(&rValue, pData, sizeof(qint32));
     rValue = qFromLittleEndian(rValue);
@@ -312,42 +317,35 @@ qint32 DataHandling::getHandleSeasonTicketListResponse(MessageProtocol* msg)
     updateIndex = qFromLittleEndian(updateIndex);
     offset += 2;
 
+    SeasonTicketValues values;
     this->m_pGlobalData->startUpdateSeasonTickets(updateIndex);
     while (offset + TICKET_OFFSET < totalSize) {
-        SeasonTicketItem* sTicket = new SeasonTicketItem();
-        quint16           size    = qFromLittleEndian(*(qint16*)(pData + offset));
+        quint16 size = qFromLittleEndian<quint16>((const uchar*)(pData + offset));
         offset += 2;
 
-        if (size <= 8) {
-            qWarning().noquote() << QString("Size is to small %1").arg(size);
-            delete sTicket;
-            break;
+        if (size <= 8 || offset + size > totalSize) {
+            qWarning().noquote() << QString("Size is wrong %1").arg(size);
+            return ERROR_CODE_WRONG_SIZE;
         }
 
-        sTicket->setDiscount(*(quint8*)(pData + offset));
-        offset += 1;
-        sTicket->setIndex(qFromLittleEndian(*(quint32*)(pData + offset)));
-        offset += 4;
-        sTicket->setUserIndex(qFromLittleEndian(*(quint32*)(pData + offset)));
-        offset += 4;
-        sTicket->checkTicketOwn(userIndex);
+        const uchar* pRecord = (const uchar*)(pData + offset);
+        values.m_discount    = pRecord[0];
+        values.m_index       = qFromLittleEndian<quint32>(pRecord + 1);
+        values.m_userIndex   = qFromLittleEndian<quint32>(pRecord + 5);
 
-        QString ticketString(QByteArray(pData + offset, size - TICKET_OFFSET));
-        offset += (size - TICKET_OFFSET);
-        QStringList lsticketString = ticketString.split(";");
+        const char* pField = pData + offset + TICKET_OFFSET;
+        const char* pEnd   = pData + offset + size;
+        values.m_name      = readNextField(pField, pEnd);
+        values.m_place     = readNextField(pField, pEnd);
+        offset += size;
 
-        if (lsticketString.size() > 0)
-            sTicket->setName(lsticketString.value(0));
-        if (lsticketString.size() > 1)
-            sTicket->setPlace(lsticketString.value(1));
-
-        QQmlEngine::setObjectOwnership(sTicket, QQmlEngine::CppOwnership);
-        this->m_pGlobalData->addNewSeasonTicket(sTicket, updateIndex);
+        this->m_pGlobalData->addNewSeasonTicket(values, updateIndex);
     }
+    if (offset + sizeof(qint64) > totalSize)
+        return ERROR_CODE_WRONG_SIZE;
+    this->m_pGlobalData->finishUpdateSeasonTickets();
 
-    qint64 serverTimeStamp;
-    memcpy(&serverTimeStamp, pData + offset, sizeof(qint64));
-    serverTimeStamp = qFromLittleEndian(serverTimeStamp);
+    qint64 serverTimeStamp = qFromLittleEndian<qint64>((const uchar*)(pData + offset));
 
     this->m_pGlobalData->saveCurrentSeasonTickets(serverTimeStamp);
 
@@ -0,0 +1,67 @@
+##########################################################################################
+#	File:		AppBench.pro
+#	Project:	StamOrga
+#
+#	Brief:		benchmarks of the StamOrga app, run the binary to get the report
+#	Author:		msc
+#	Date:		19.10.2026
+#
+###########################################################################################
+
+
+QT += qml quick network testlib
+
+CONFIG += c++11
+CONFIG += console
+CONFIG -= app_bundle
+
+DEFINES += STAMORGA_APP
+
+TARGET = bench_app
+
+TEMPLATE = app
+
+
+include (../Tests.pri)
+
+# the app includes "../Data/..." relative to its project folder
+INCLUDEPATH += ../../StamOrga/Android
+
+
+SOURCES += bench_app.cpp \
+    ../../Common/General/backgroundcontroller.cpp \
+    ../../Common/General/backgroundworker.cpp \
+    ../../Common/General/logging.cpp \
+    ../../Common/General/logbinaryformat.cpp \
+    ../../Common/General/globalfunctions.cpp \
+    ../../Common/Network/messageprotocol.cpp \
+    ../../StamOrga/datahandling.cpp \
+    ../../StamOrga/Data/globaldata.cpp \
+    ../../StamOrga/Data/gameplay.cpp \
+    ../../StamOrga/Data/seasonticket.cpp \
+    ../../StamOrga/Data/meetinginfo.cpp \
+    ../../StamOrga/Data/globalsettings.cpp \
+    ../../StamOrga/Data/localcache.cpp \
+    ../../StamOrga/Data/gameplaymodel.cpp \
+    ../../StamOrga/Data/seasonticketmodel.cpp
+
+HEADERS += \
+    ../../Common/General/backgroundcontroller.h \
+    ../../Common/General/backgroundworker.h \
+    ../../Common/General/config.h \
+    ../../Common/General/logging.h \
+    ../../Common/General/logbinaryformat.h \
+    ../../Common/General/globaltiming.h \
+    ../../Common/General/globalfunctions.h \
+    ../../Common/Network/messagecommand.h \
+    ../../Common/Network/messageprotocol.h \
+    ../../StamOrga/datahandling.h \
+    ../../StamOrga/Data/globaldata.h \
+    ../../StamOrga/Data/gameplay.h \
+    ../../StamOrga/Data/seasonticket.h \
+    ../../StamOrga/Data/meetinginfo.h \
+    ../../StamOrga/Data/acceptmeetinginfo.h \
+    ../../StamOrga/Data/globalsettings.h \
+    ../../StamOrga/Data/localcache.h \
+    ../../StamOrga/Data/gameplaymodel.h \
+    ../../StamOrga/Data/seasonticketmodel.h
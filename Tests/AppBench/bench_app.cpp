@@ -0,0 +1,372 @@
+/*
+*	This file is part of StamOrga
+*   Copyright (C) 2017 Markus Schneider
+*
+*	This program is free software; you can redistribute it and/or modify
+*   it under the terms of the GNU General Public License as published by
+*   the Free Software Foundation; either version 3 of the License, or
+*   (at your option) any later version.
+*
+*	StamOrga is distributed in the hope that it will be useful,
+*    but WITHOUT ANY WARRANTY; without even the implied warranty of
+*    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+*    GNU General Public License for more details.
+
+*    You should have received a copy of the GNU General Public License
+*    along with StamOrga.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include <QtCore/QDataStream>
+#include <QtCore/QDateTime>
+#include <QtCore/QLoggingCategory>
+#include <QtCore/QStandardPaths>
+#include <QtCore/QTemporaryDir>
+#include <QtTest/QtTest>
+
+#include "../../Common/Network/messagecommand.h"
+#include "../../StamOrga/Data/globaldata.h"
+#include "../../StamOrga/Data/globalsettings.h"
+#include "../../StamOrga/dataconnection.h"
+#include "../../StamOrga/datahandling.h"
+
+#define TICKET_NAME QString::fromUtf8("Dauerkarte Müller")
+#define TICKET_PLACE QString::fromUtf8("Block E1, Reihe 12, Platz 7")
+
+#define BENCH_SEASONS 8
+#define BENCH_SEASON_GAMES 40 /* 38 matchdays and two cup games */
+#define BENCH_MATCH_DAYS 38
+#define BENCH_GAME_INFO_SIZE 18
+#define BENCH_LIST_GAMES 500
+#define BENCH_GAMES_OFFSET (1 + 1 + 8 + 4)
+
+GlobalSettings* g_GlobalSettings;
+
+class AppBench : public QObject
+{
+    Q_OBJECT
+
+private slots:
+    void initTestCase();
+    void cleanupTestCase();
+
+    void requestEncoding_data();
+    void requestEncoding();
+    void gamePlayLookup();
+    void gamesInfoListResponse();
+    void gamesListResponse_data();
+    void gamesListResponse();
+
+private:
+    QTemporaryDir* m_home;
+    GlobalData*    m_globalData;
+
+    void addSeasons(int countSeasons);
+};
+
+void AppBench::initTestCase()
+{
+    /* the app logs every decoded list, only the results of the benchmarks are printed */
+    QLoggingCategory::setFilterRules("default.debug=false");
+    QStandardPaths::setTestModeEnabled(true);
+
+    /* the settings, the log and the cache are written to an empty home */
+    this->m_home = new QTemporaryDir();
+    QVERIFY(this->m_home->isValid());
+    qputenv("HOME", this->m_home->path().toUtf8());
+
+    g_GlobalSettings = new GlobalSettings();
+    g_GlobalSettings->setSaveInfosOnApp(true);
+
+    /* one global data like in the app, the benchmarks send full lists which replace the games */
+    this->m_globalData = new GlobalData();
+}
+
+void AppBench::cleanupTestCase()
+{
+    /* the logging of the app is stopped with the global data */
+    qInstallMessageHandler(0);
+    delete this->m_globalData;
+    delete g_GlobalSettings;
+    g_GlobalSettings = NULL;
+    delete this->m_home;
+}
+
+/* The game with the index, the indexes go on over the seasons like on the server */
+static GamePlayValues benchGame(quint32 index)
+{
+    quint32 season = (index - 1) / BENCH_SEASON_GAMES;
+    quint32 pos    = (index - 1) % BENCH_SEASON_GAMES + 1;
+
+    GamePlayValues values;
+    values.m_index       = index;
+    values.m_seasonIndex = quint8(pos <= BENCH_MATCH_DAYS ? pos : pos - BENCH_MATCH_DAYS);
+    values.m_competition = pos <= BENCH_MATCH_DAYS ? LIGA_3 : DFB_POKAL;
+    values.m_timeFixed   = pos % 3 == 0;
+    values.m_timestamp   = QDateTime(QDate(2010 + season, 7, 20), QTime(14, 0)).addDays(7 * pos).toMSecsSinceEpoch();
+    values.m_home        = QString("Team %1").arg(index % 19 + 1);
+    values.m_away        = "KSC";
+    values.m_score       = QString("%1:%2").arg(index % 4).arg(index % 3);
+    return values;
+}
+
+void AppBench::addSeasons(int countSeasons)
+{
+    this->m_globalData->startUpdateGamesPlay(UpdateIndex::UpdateAll);
+    for (int i = 1; i <= countSeasons * BENCH_SEASON_GAMES; i++)
+        this->m_globalData->addNewGamePlay(benchGame(i), UpdateIndex::UpdateAll);
+    this->m_globalData->finishUpdateGamesPlay();
+}
+
+/* The requests as ConnectionHandling writes them and DataConnection sends them */
+static QByteArray typedEditSeasonTicket(quint32 index, const QString& name, const QString& place, quint32 discount)
+{
+    DataConRequest req(OP_CODE_CMD_REQ::REQ_CHANGE_TICKET);
+    req.appendUInt32(index);
+    req.appendUInt32(discount);
+    req.appendString(name);
+    req.appendString(place);
+
+    DataConRequest  queued = req; /* copied by the queued signal to the data connection */
+    MessageProtocol msg(queued.m_request, queued.m_payload);
+    return QByteArray(msg.getPointerToData(), msg.getDataLength());
+}
+
+static QByteArray typedChangeSeasonTicketState(quint32 ticketIndex, quint32 gameIndex, quint32 state, const QString& name)
+{
+    DataConRequest req(OP_CODE_CMD_REQ::REQ_STATE_CHANGE_SEASON_TICKET);
+    req.appendUInt32(ticketIndex);
+    req.appendUInt32(gameIndex);
+    req.appendUInt32(state);
+    req.appendSizedString(name);
+
+    DataConRequest  queued = req;
+    MessageProtocol msg(queued.m_request, queued.m_payload);
+    return QByteArray(msg.getPointerToData(), msg.getDataLength());
+}
+
+static QByteArray typedSaveMeetingInfo(quint32 gameIndex, const QString& when, const QString& where, const QString& info)
+{
+    DataConRequest req(OP_CODE_CMD_REQ::REQ_CHANGE_MEETING_INFO);
+    req.appendUInt32(gameIndex);
+    req.appendString(when);
+    req.appendString(where);
+    req.appendString(info);
+
+    DataConRequest  queued = req;
+    MessageProtocol msg(queued.m_request, queued.m_payload);
+    return QByteArray(msg.getPointerToData(), msg.getDataLength());
+}
+
+/* The former way over m_lData, numbers went to text and back into fixed buffers */
+static QByteArray stringsEditSeasonTicket(quint32 index, const QString& name, const QString& place, quint32 discount)
+{
+    DataConRequest req(OP_CODE_CMD_REQ::REQ_CHANGE_TICKET);
+    req.m_lData.append(QString::number(index));
+    req.m_lData.append(name);
+    req.m_lData.append(place);
+    req.m_lData.append(QString::number(discount));
+
+    DataConRequest queued         = req;
+    quint32        ticketIndex    = qToLittleEndian(queued.m_lData.at(0).toUInt());
+    QByteArray     ticketName     = queued.m_lData.at(1).toUtf8();
+    QByteArray     ticketPlace    = queued.m_lData.at(2).toUtf8();
+    quint32        ticketDiscount = qToLittleEndian(queued.m_lData.at(3).toUInt());
+    char           data[200];
+    memset(&data[0], 0x0, 200);
+    memcpy(&data[0], &ticketIndex, sizeof(quint32));
+    memcpy(&data[4], &ticketDiscount, sizeof(quint32));
+    memcpy(&data[8], ticketName.constData(), ticketName.length());
+    memcpy(&data[9 + ticketName.length()], ticketPlace.constData(), ticketPlace.length());
+
+    quint32 size = 8 + ticketName.length() + ticketPlace.length() + 2;
+
+    MessageProtocol msg(queued.m_request, &data[0], size);
+    return QByteArray(msg.getPointerToData(), msg.getDataLength());
+}
+
+static QByteArray stringsChangeSeasonTicketState(quint32 ticketIndex, quint32 gameIndex, quint32 state, const QString& name)
+{
+    DataConRequest req(OP_CODE_CMD_REQ::REQ_STATE_CHANGE_SEASON_TICKET);
+    req.m_lData.append(QString::number(ticketIndex));
+    req.m_lData.append(QString::number(gameIndex));
+    req.m_lData.append(QString::number(state));
+    req.m_lData.append(name);
+
+    DataConRequest queued = req;
+    QByteArray     seasonTicket;
+    QString        ticketName = queued.m_lData.at(3);
+    QDataStream    wSeasonTicket(&seasonTicket, QIODevice::WriteOnly);
+    wSeasonTicket.setByteOrder(QDataStream::LittleEndian);
+    wSeasonTicket << queued.m_lData.at(0).toUInt();
+    wSeasonTicket << queued.m_lData.at(1).toUInt();
+    wSeasonTicket << queued.m_lData.at(2).toUInt();
+    wSeasonTicket << quint16(ticketName.toUtf8().size());
+    seasonTicket.append(ticketName.toUtf8());
+
+    MessageProtocol msg(queued.m_request, seasonTicket);
+    return QByteArray(msg.getPointerToData(), msg.getDataLength());
+}
+
+static QByteArray stringsSaveMeetingInfo(quint32 gameIndex, const QString& when, const QString& where, const QString& info)
+{
+    DataConRequest req(OP_CODE_CMD_REQ::REQ_CHANGE_MEETING_INFO);
+    req.m_lData.append(QString::number(gameIndex));
+    req.m_lData.append(when);
+    req.m_lData.append(where);
+    req.m_lData.append(info);
+
+    DataConRequest queued = req;
+    QByteArray     data;
+    QDataStream    wData(&data, QIODevice::WriteOnly);
+    wData.setByteOrder(QDataStream::LittleEndian);
+    wData << queued.m_lData.at(0).toUInt();
+    data.append(queued.m_lData.at(1).toUtf8());
+    data.append(char(0x00));
+    data.append(queued.m_lData.at(2).toUtf8());
+    data.append(char(0x00));
+    data.append(queued.m_lData.at(3).toUtf8());
+    data.append(char(0x00));
+
+    MessageProtocol msg(queued.m_request, data);
+    return QByteArray(msg.getPointerToData(), msg.getDataLength());
+}
+
+void AppBench::requestEncoding_data()
+{
+    QTest::addColumn<bool>("typed");
+
+    QTest::newRow("typed") << true;
+    QTest::newRow("strings") << false;
+}
+
+/* A ticket change, a state change and a meeting info, the frames of both ways are the same */
+void AppBench::requestEncoding()
+{
+    QFETCH(bool, typed);
+
+    QCOMPARE(typedEditSeasonTicket(17, TICKET_NAME, TICKET_PLACE, 1), stringsEditSeasonTicket(17, TICKET_NAME, TICKET_PLACE, 1));
+    QCOMPARE(typedChangeSeasonTicketState(17, 312, 2, TICKET_NAME), stringsChangeSeasonTicketState(17, 312, 2, TICKET_NAME));
+    QCOMPARE(typedSaveMeetingInfo(312, "11:30", "Hauptbahnhof", "Gleis 3"), stringsSaveMeetingInfo(312, "11:30", "Hauptbahnhof", "Gleis 3"));
+
+    int size = 0;
+    if (typed) {
+        QBENCHMARK {
+            size += typedEditSeasonTicket(17, TICKET_NAME, TICKET_PLACE, 1).size();
+            size += typedChangeSeasonTicketState(17, 312, 2, TICKET_NAME).size();
+            size += typedSaveMeetingInfo(312, "11:30", "Hauptbahnhof", "Gleis 3").size();
+        }
+    } else {
+        QBENCHMARK {
+            size += stringsEditSeasonTicket(17, TICKET_NAME, TICKET_PLACE, 1).size();
+            size += stringsChangeSeasonTicketState(17, 312, 2, TICKET_NAME).size();
+            size += stringsSaveMeetingInfo(312, "11:30", "Hauptbahnhof", "Gleis 3").size();
+        }
+    }
+    QVERIFY(size > 0);
+}
+
+/* Every game of all seasons is looked up once, like the models and the answer handling do */
+void AppBench::gamePlayLookup()
+{
+    const quint32 countGames = BENCH_SEASONS * BENCH_SEASON_GAMES;
+    this->addSeasons(BENCH_SEASONS);
+    QCOMPARE(this->m_globalData->getGamePlayLength(), countGames);
+
+    quint32 found = 0;
+    QBENCHMARK {
+        found = 0;
+        for (quint32 i = countGames; i > 0; i--) {
+            if (this->m_globalData->getGamePlay(i) != NULL)
+                found++;
+        }
+    }
+    QCOMPARE(found, countGames);
+}
+
+/* The infos of every second game of all seasons, the other games are set back to zero */
+void AppBench::gamesInfoListResponse()
+{
+    const quint32 countGames = BENCH_SEASONS * BENCH_SEASON_GAMES;
+    this->addSeasons(BENCH_SEASONS);
+
+    QByteArray  answer;
+    QDataStream wAnswer(&answer, QIODevice::WriteOnly);
+    wAnswer.setByteOrder(QDataStream::LittleEndian);
+    wAnswer << qint32(ERROR_CODE_SUCCESS) << quint32(0);
+    wAnswer << quint16(BENCH_GAME_INFO_SIZE) << quint16(0);
+    for (quint32 i = 1; i <= countGames; i += 2)
+        wAnswer << i << quint16(i % 5) << quint16(0) << quint16(i % 2) << quint16(3) << quint16(1) << quint16(0) << quint16(1);
+    MessageProtocol msg(OP_CODE_CMD_RES::ACK_GET_GAMES_INFO_LIST, answer);
+
+    DataHandling dataHandling(this->m_globalData);
+    QCOMPARE(dataHandling.getHandleGamesInfoListResponse(&msg), qint32(ERROR_CODE_SUCCESS));
+    QCOMPARE(this->m_globalData->getGamePlay(1)->getAcceptedMeetingCount(), quint16(3));
+
+    QBENCHMARK {
+        dataHandling.getHandleGamesInfoListResponse(&msg);
+    }
+}
+
+/* A games list answer of the server with all games, the scores can be shifted to get changes */
+static QByteArray createGamesListAnswer(quint32 countGames, quint32 scoreShift, qint64 timestamp)
+{
+    QByteArray  answer;
+    QDataStream wAnswer(&answer, QIODevice::WriteOnly);
+    wAnswer.setByteOrder(QDataStream::LittleEndian);
+    wAnswer << qint32(ERROR_CODE_SUCCESS) << qint16(UpdateIndex::UpdateAll);
+
+    for (quint32 i = 1; i <= countGames; i++) {
+        GamePlayValues values = benchGame(i);
+        QByteArray     game   = QString("%1;%2;%3:%4").arg(values.m_home, values.m_away).arg(i % 4 + scoreShift).arg(i % 3).toUtf8();
+
+        wAnswer.device()->seek(answer.size());
+        wAnswer << quint16(game.size() + BENCH_GAMES_OFFSET);
+        wAnswer << values.m_seasonIndex;
+        wAnswer << quint8(quint8(values.m_competition) | quint8(values.m_timeFixed ? 0x80 : 0x0));
+        wAnswer << values.m_timestamp;
+        wAnswer << values.m_index;
+        answer.append(game);
+    }
+    wAnswer.device()->seek(answer.size());
+    wAnswer << timestamp;
+
+    return answer;
+}
+
+void AppBench::gamesListResponse_data()
+{
+    QTest::addColumn<bool>("changed");
+
+    QTest::newRow("unchanged") << false;
+    QTest::newRow("scores changed") << true;
+}
+
+/*
+ * A full list of 500 games is decoded twice per iteration. Without changes the known games stay
+ * as they are, with changes every game gets a new score and the cache is written.
+ */
+void AppBench::gamesListResponse()
+{
+    QFETCH(bool, changed);
+
+    QByteArray      firstAnswer  = createGamesListAnswer(BENCH_LIST_GAMES, 0, 1000);
+    QByteArray      secondAnswer = createGamesListAnswer(BENCH_LIST_GAMES, changed ? 1 : 0, changed ? 2000 : 1000);
+    MessageProtocol firstMsg(OP_CODE_CMD_RES::ACK_GET_GAMES_LIST, firstAnswer);
+    MessageProtocol secondMsg(OP_CODE_CMD_RES::ACK_GET_GAMES_LIST, secondAnswer);
+
+    DataHandling dataHandling(this->m_globalData);
+    QCOMPARE(dataHandling.getHandleGamesListResponse(&firstMsg), qint32(ERROR_CODE_SUCCESS));
+    QCOMPARE(this->m_globalData->getGamePlayLength(), quint32(BENCH_LIST_GAMES));
+    QCOMPARE(dataHandling.getHandleGamesListResponse(&secondMsg), qint32(ERROR_CODE_SUCCESS));
+    QCOMPARE(this->m_globalData->getGamePlay(BENCH_LIST_GAMES)->score(), QString("%1:%2").arg(BENCH_LIST_GAMES % 4 + (changed ? 1 : 0)).arg(BENCH_LIST_GAMES % 3));
+
+    QBENCHMARK {
+        dataHandling.getHandleGamesListResponse(&firstMsg);
+        dataHandling.getHandleGamesListResponse(&secondMsg);
+    }
+    QCOMPARE(this->m_globalData->getGamePlayLength(), quint32(BENCH_LIST_GAMES));
+}
+
+QTEST_GUILESS_MAIN(AppBench)
+
+#include "bench_app.moc"
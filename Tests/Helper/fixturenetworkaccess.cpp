@@ -0,0 +1,175 @@
+/*
+*	This file is part of StamOrga
+*   Copyright (C) 2017 Markus Schneider
+*
+*	This program is free software; you can redistribute it and/or modify
+*   it under the terms of the GNU General Public License as published by
+*   the Free Software Foundation; either version 3 of the License, or
+*   (at your option) any later version.
+*
+*	StamOrga is distributed in the hope that it will be useful,
+*    but WITHOUT ANY WARRANTY; without even the implied warranty of
+*    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+*    GNU General Public License for more details.
+
+*    You should have received a copy of the GNU General Public License
+*    along with StamOrga.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include <QtCore/QCryptographicHash>
+#include <QtCore/QFile>
+#include <QtCore/QSettings>
+#include <QtCore/QTimer>
+
+#include "../../Common/General/globalfunctions.h"
+#include "fixturenetworkaccess.h"
+
+FixtureReply::FixtureReply(const QNetworkRequest& request, int status, const QByteArray& data, const QByteArray& eTag, int delay, QObject* parent)
+    : QNetworkReply(parent)
+{
+    this->m_data   = data;
+    this->m_offset = 0;
+
+    this->setRequest(request);
+    this->setUrl(request.url());
+    this->setOperation(QNetworkAccessManager::GetOperation);
+    this->setAttribute(QNetworkRequest::HttpStatusCodeAttribute, status);
+    if (!eTag.isEmpty())
+        this->setRawHeader("ETag", eTag);
+    this->setRawHeader("Content-Type", "application/json; charset=utf-8");
+    if (status == 404)
+        this->setError(QNetworkReply::ContentNotFoundError, "No fixture for " + request.url().path());
+    this->open(QIODevice::ReadOnly | QIODevice::Unbuffered);
+
+    QTimer::singleShot(delay, this, &FixtureReply::slotFinish);
+}
+
+void FixtureReply::slotFinish()
+{
+    if (this->isFinished())
+        return;
+
+    this->setFinished(true);
+    if (this->m_data.size() > 0)
+        emit this->readyRead();
+    emit this->finished();
+}
+
+void FixtureReply::abort()
+{
+    if (this->isFinished())
+        return;
+
+    this->m_data.clear();
+    this->setError(QNetworkReply::OperationCanceledError, "Operation canceled");
+    this->setFinished(true);
+    emit this->error(QNetworkReply::OperationCanceledError);
+    emit this->finished();
+}
+
+qint64 FixtureReply::bytesAvailable() const
+{
+    return this->m_data.size() - this->m_offset + QNetworkReply::bytesAvailable();
+}
+
+qint64 FixtureReply::readData(char* data, qint64 maxSize)
+{
+    if (this->m_offset >= this->m_data.size())
+        return this->isFinished() ? -1 : 0;
+
+    qint64 size = qMin(maxSize, this->m_data.size() - this->m_offset);
+    memcpy(data, this->m_data.constData() + this->m_offset, size);
+    this->m_offset += size;
+    return size;
+}
+
+
+FixtureNetworkAccess::FixtureNetworkAccess(const QString& fixturePath, QObject* parent)
+    : QNetworkAccessManager(parent)
+{
+    this->m_fixturePath  = fixturePath;
+    this->m_defaultDelay = 0;
+    this->m_notModified  = 0;
+}
+
+void FixtureNetworkAccess::clearCounters()
+{
+    this->m_lRequestedPaths.clear();
+    this->m_lFinishedPaths.clear();
+    this->m_notModified = 0;
+}
+
+bool FixtureNetworkAccess::writeOnlineConfig(quint32 maxIndex, const QStringList& teams)
+{
+    QString configFilePath = getUserHomeConfigPath() + "/Settings/OnlineGames.ini";
+    if (!checkFilePathExistAndCreate(configFilePath))
+        return false;
+
+    QSettings settings(configFilePath, QSettings::IniFormat);
+    settings.setIniCodec(("UTF-8"));
+
+    settings.beginGroup("Source");
+    settings.setValue("url", FIXTURE_SOURCE_URL);
+    settings.endGroup();
+
+    settings.beginWriteArray("Competition");
+    settings.setArrayIndex(0);
+    settings.setValue("name", "bl3");
+    settings.setValue("season", 2017);
+    settings.setValue("maxIndex", maxIndex);
+    settings.endArray();
+
+    settings.beginWriteArray("Team");
+    for (int i = 0; i < teams.size(); i++) {
+        settings.setArrayIndex(i);
+        settings.setValue("name", teams[i].section('=', 0, 0));
+        settings.setValue("shortName", teams[i].section('=', 1, 1));
+    }
+    settings.endArray();
+    settings.sync();
+
+    return settings.status() == QSettings::NoError;
+}
+
+QNetworkReply* FixtureNetworkAccess::createRequest(Operation op, const QNetworkRequest& request, QIODevice* outgoingData)
+{
+    Q_UNUSED(op);
+    Q_UNUSED(outgoingData);
+
+    QString path   = request.url().toString().mid(QString(FIXTURE_SOURCE_URL).size() + 1);
+    int     delay  = this->m_replyDelays.value(path, this->m_defaultDelay);
+    int     status = 404;
+
+    QByteArray data, eTag;
+    if (this->readFixture(path, data)) {
+        status = 200;
+        eTag   = "\"" + QCryptographicHash::hash(data, QCryptographicHash::Md5).toHex() + "\"";
+        if (request.rawHeader("If-None-Match") == eTag) {
+            status = 304;
+            data.clear();
+            this->m_notModified++;
+        }
+    }
+    this->m_lRequestedPaths.append(path);
+
+    FixtureReply* reply = new FixtureReply(request, status, data, eTag, delay, this);
+    connect(reply, &QNetworkReply::finished, this, [this, path]() { this->m_lFinishedPaths.append(path); });
+    return reply;
+}
+
+bool FixtureNetworkAccess::readFixture(const QString& path, QByteArray& data)
+{
+    QStringList dirs;
+    if (!this->m_overlayPath.isEmpty())
+        dirs.append(this->m_overlayPath);
+    dirs.append(this->m_fixturePath);
+
+    foreach (const QString& dir, dirs) {
+        QFile file(dir + "/" + path + ".json");
+        if (file.open(QIODevice::ReadOnly)) {
+            data = file.readAll();
+            return true;
+        }
+    }
+    return false;
+}
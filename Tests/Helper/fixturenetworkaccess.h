@@ -0,0 +1,95 @@
+/*
+*	This file is part of StamOrga
+*   Copyright (C) 2017 Markus Schneider
+*
+*	This program is free software; you can redistribute it and/or modify
+*   it under the terms of the GNU General Public License as published by
+*   the Free Software Foundation; either version 3 of the License, or
+*   (at your option) any later version.
+*
+*	StamOrga is distributed in the hope that it will be useful,
+*    but WITHOUT ANY WARRANTY; without even the implied warranty of
+*    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+*    GNU General Public License for more details.
+
+*    You should have received a copy of the GNU General Public License
+*    along with StamOrga.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#ifndef FIXTURENETWORKACCESS_H
+#define FIXTURENETWORKACCESS_H
+
+#include <QtCore/QHash>
+#include <QtCore/QStringList>
+#include <QtNetwork/QNetworkAccessManager>
+#include <QtNetwork/QNetworkReply>
+
+/* Source url to configure for ReadOnlineGames, the path behind it is the path of the fixture */
+#define FIXTURE_SOURCE_URL "http://openligadb.fixture/api"
+
+/*
+ * Answer of a recorded request, it is finished after the delay like a real reply. An aborted
+ * reply finishes at once with OperationCanceledError.
+ */
+class FixtureReply : public QNetworkReply
+{
+    Q_OBJECT
+public:
+    FixtureReply(const QNetworkRequest& request, int status, const QByteArray& data, const QByteArray& eTag, int delay, QObject* parent = 0);
+
+    void   abort() override;
+    qint64 bytesAvailable() const override;
+    bool   isSequential() const override { return true; }
+
+protected:
+    qint64 readData(char* data, qint64 maxSize) override;
+
+private slots:
+    void slotFinish();
+
+private:
+    QByteArray m_data;
+    qint64     m_offset;
+};
+
+/*
+ * Serves recorded openligadb answers from files instead of the network. The url
+ * FIXTURE_SOURCE_URL/getmatchdata/bl3/2017/3 is answered with getmatchdata/bl3/2017/3.json,
+ * first from the overlay path (e.g. one step of a live game) and then from the fixture path.
+ * ETags are the md5 of the file, so a request with the same If-None-Match gets 304.
+ */
+class FixtureNetworkAccess : public QNetworkAccessManager
+{
+    Q_OBJECT
+public:
+    explicit FixtureNetworkAccess(const QString& fixturePath, QObject* parent = 0);
+
+    void setOverlayPath(const QString& overlayPath) { this->m_overlayPath = overlayPath; }
+    void setDefaultDelay(int msec) { this->m_defaultDelay = msec; }
+    void setReplyDelay(const QString& path, int msec) { this->m_replyDelays.insert(path, msec); }
+
+    /* paths of the requests in the order they were send and in the order they were answered */
+    QStringList requestedPaths() const { return this->m_lRequestedPaths; }
+    QStringList finishedPaths() const { return this->m_lFinishedPaths; }
+    quint32     notModifiedCount() const { return this->m_notModified; }
+    void        clearCounters();
+
+    /* writes OnlineGames.ini to read bl3 2017 from the fixtures, teams are given as "name=shortName" */
+    static bool writeOnlineConfig(quint32 maxIndex, const QStringList& teams);
+
+protected:
+    QNetworkReply* createRequest(Operation op, const QNetworkRequest& request, QIODevice* outgoingData = 0) override;
+
+private:
+    QString             m_fixturePath;
+    QString             m_overlayPath;
+    int                 m_defaultDelay;
+    QHash<QString, int> m_replyDelays;
+    QStringList         m_lRequestedPaths;
+    QStringList         m_lFinishedPaths;
+    quint32             m_notModified;
+
+    bool readFixture(const QString& path, QByteArray& data);
+};
+
+#endif // FIXTURENETWORKACCESS_H
@@ -0,0 +1,67 @@
+##########################################################################################
+#	File:		ServerBench.pro
+#	Project:	StamOrga
+#
+#	Brief:		benchmarks of the StFaeKSC server, run the binary to get the report
+#	Author:		msc
+#	Date:		19.10.2026
+#
+###########################################################################################
+
+
+QT += core network testlib
+QT -= gui
+
+CONFIG += c++11
+CONFIG += console
+CONFIG -= app_bundle
+
+TARGET = bench_server
+
+TEMPLATE = app
+
+
+include (../Tests.pri)
+
+# the server includes "../Common/..." relative to its project folder
+INCLUDEPATH += ../../StFaeKSC
+
+
+SOURCES += bench_server.cpp \
+    ../Helper/fixturenetworkaccess.cpp \
+    ../../Common/General/backgroundcontroller.cpp \
+    ../../Common/General/backgroundworker.cpp \
+    ../../Common/General/globalfunctions.cpp \
+    ../../Common/Network/messageprotocol.cpp \
+    ../../Common/Network/messagecompression.cpp \
+    ../../Common/Network/messagecommand.cpp \
+    ../../StFaeKSC/General/dataconnection.cpp \
+    ../../StFaeKSC/General/globaldata.cpp \
+    ../../StFaeKSC/General/serverstatistics.cpp \
+    ../../StFaeKSC/Data/listeduser.cpp \
+    ../../StFaeKSC/Data/games.cpp \
+    ../../StFaeKSC/Data/seasonticket.cpp \
+    ../../StFaeKSC/Data/configlist.cpp \
+    ../../StFaeKSC/Data/readonlinegames.cpp \
+    ../../StFaeKSC/Data/availablegameticket.cpp \
+    ../../StFaeKSC/Data/meetinginfo.cpp
+
+HEADERS += \
+    ../Helper/fixturenetworkaccess.h \
+    ../../Common/General/backgroundcontroller.h \
+    ../../Common/General/backgroundworker.h \
+    ../../Common/General/globalfunctions.h \
+    ../../Common/Network/messageprotocol.h \
+    ../../Common/Network/messagecompression.h \
+    ../../Common/Network/messagecommand.h \
+    ../../StFaeKSC/General/dataconnection.h \
+    ../../StFaeKSC/Network/connectiondata.h \
+    ../../StFaeKSC/General/globaldata.h \
+    ../../StFaeKSC/General/serverstatistics.h \
+    ../../StFaeKSC/Data/listeduser.h \
+    ../../StFaeKSC/Data/games.h \
+    ../../StFaeKSC/Data/seasonticket.h \
+    ../../StFaeKSC/Data/configlist.h \
+    ../../StFaeKSC/Data/readonlinegames.h \
+    ../../StFaeKSC/Data/availablegameticket.h \
+    ../../StFaeKSC/Data/meetinginfo.h
@@ -0,0 +1,274 @@
+/*
+*	This file is part of StamOrga
+*   Copyright (C) 2017 Markus Schneider
+*
+*	This program is free software; you can redistribute it and/or modify
+*   it under the terms of the GNU General Public License as published by
+*   the Free Software Foundation; either version 3 of the License, or
+*   (at your option) any later version.
+*
+*	StamOrga is distributed in the hope that it will be useful,
+*    but WITHOUT ANY WARRANTY; without even the implied warranty of
+*    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+*    GNU General Public License for more details.
+
+*    You should have received a copy of the GNU General Public License
+*    along with StamOrga.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include <QtCore/QDataStream>
+#include <QtCore/QDateTime>
+#include <QtCore/QLoggingCategory>
+#include <QtCore/QTemporaryDir>
+#include <QtCore/QtEndian>
+#include <QtTest/QSignalSpy>
+#include <QtTest/QtTest>
+
+#include "../../Common/Network/messagecommand.h"
+#include "../../StFaeKSC/Data/readonlinegames.h"
+#include "../../StFaeKSC/General/dataconnection.h"
+#include "../../StFaeKSC/General/globaldata.h"
+#include "../Helper/fixturenetworkaccess.h"
+
+#define FIXTURE_OPENLIGADB FIXTURE_PATH "/openligadb"
+#define ROUND_TIMEOUT_MSEC 10000
+#define SEASON_MATCH_DAYS 38
+#define BENCH_GAMES 40
+#define BENCH_TICKETS 15
+#define BENCH_USER "bench"
+
+/* only the report of the benchmark is printed, not the log of the server */
+#define BENCH_LOG_RULES "default.debug=false\ndefault.info=false\nstamorga.bench.info=true"
+
+Q_LOGGING_CATEGORY(logBench, "stamorga.bench")
+
+/* Lets the replay start a round with every known game, like all their events were reached */
+class ReplayReadOnlineGames : public ReadOnlineGames
+{
+public:
+    OnlineGameInfo* onlineGame(quint32 index)
+    {
+        foreach (OnlineGameInfo* info, this->m_onlineGames) {
+            if (info->m_index == index)
+                return info;
+        }
+        return NULL;
+    }
+
+    void startRoundWithAllGames()
+    {
+        this->m_networkUpdate->stop();
+        this->m_eventHeap.clear();
+        foreach (OnlineGameInfo* info, this->m_onlineGames) {
+            OnlineGameEvent event;
+            event.m_time      = 1;
+            event.m_info      = info;
+            info->m_nextEvent = event.m_time;
+            this->m_eventHeap.append(event);
+        }
+        this->checkNewNetworkRequest(false);
+    }
+};
+
+class ServerBench : public QObject
+{
+    Q_OBJECT
+
+private slots:
+    void initTestCase();
+    void init();
+    void cleanup();
+
+    void replayLiveGame();
+    void handlerThroughput_data();
+    void handlerThroughput();
+
+private:
+    QTemporaryDir* m_home;
+    GlobalData*    m_globalData;
+
+    void setGamesBeforeRecording();
+    void reportRound(const QString& name, const OnlineRoundStats& stats, FixtureNetworkAccess& netAccess);
+};
+
+void ServerBench::initTestCase()
+{
+    QLoggingCategory::setFilterRules(BENCH_LOG_RULES);
+}
+
+void ServerBench::init()
+{
+    this->m_home = new QTemporaryDir();
+    QVERIFY(this->m_home->isValid());
+    qputenv("HOME", this->m_home->path().toUtf8());
+
+    this->m_globalData = new GlobalData();
+    this->m_globalData->initialize();
+}
+
+void ServerBench::cleanup()
+{
+    delete this->m_globalData;
+    delete this->m_home;
+}
+
+/*
+ * The games got the time of the crawl as last update, the recorded answers are older. They
+ * are set back before every round, otherwise all updates are rejected as in the past.
+ */
+void ServerBench::setGamesBeforeRecording()
+{
+    Games& games = this->m_globalData->m_GamesList;
+    for (int i = 0; i < games.getNumberOfInternalList(); i++) {
+        GamesPlay* pGame = (GamesPlay*)games.getRequestConfigItemFromListIndex(i);
+        if (pGame != NULL)
+            pGame->m_lastUpdate = 1;
+    }
+}
+
+void ServerBench::reportRound(const QString& name, const OnlineRoundStats& stats, FixtureNetworkAccess& netAccess)
+{
+    qCInfo(logBench).noquote() << QString("%1: %2 requests, %3 not modified, %4 bytes, %5 games changed, %6 writes in %7ms")
+                                      .arg(name, -10)
+                                      .arg(stats.m_requests)
+                                      .arg(netAccess.notModifiedCount())
+                                      .arg(stats.m_bytes)
+                                      .arg(stats.m_changedGames)
+                                      .arg(stats.m_writes)
+                                      .arg(stats.m_duration);
+    netAccess.clearCounters();
+}
+
+/*
+ * Reads the season like a new server and then steps through the recorded answers of the
+ * last matchday while KSC is playing. Every step is one round over all games.
+ */
+void ServerBench::replayLiveGame()
+{
+#if (QT_VERSION < QT_VERSION_CHECK(5, 8, 0))
+    QSKIP("ReadOnlineGames does not send requests before Qt 5.8");
+#endif
+    QVERIFY(FixtureNetworkAccess::writeOnlineConfig(SEASON_MATCH_DAYS, QStringList() << "Karlsruher SC=KSC"));
+
+    FixtureNetworkAccess netAccess(FIXTURE_OPENLIGADB "/season");
+    ReplayReadOnlineGames reader;
+    reader.initialize(this->m_globalData);
+    reader.setNetworkAccess(&netAccess);
+
+    QSignalSpy roundSpy(&reader, SIGNAL(signalOnlineRoundFinished()));
+    reader.startBackgroundWork();
+    QVERIFY(roundSpy.count() > 0 || roundSpy.wait(ROUND_TIMEOUT_MSEC));
+    QCOMPARE(reader.getLastRoundStats().m_changedGames, quint32(SEASON_MATCH_DAYS));
+    this->reportRound("crawl", reader.getLastRoundStats(), netAccess);
+
+    /* first round over the known games, the last change of every matchday is new */
+    roundSpy.clear();
+    this->setGamesBeforeRecording();
+    reader.startRoundWithAllGames();
+    QVERIFY(roundSpy.count() > 0 || roundSpy.wait(ROUND_TIMEOUT_MSEC));
+    QCOMPARE(reader.getLastRoundStats().m_changedGames, quint32(0));
+    this->reportRound("settle", reader.getLastRoundStats(), netAccess);
+
+    /* score of KSC after each step, step 3 only changed another game of the matchday */
+    const QStringList scores = QStringList() << "0:0"
+                                             << "1:0"
+                                             << "1:0"
+                                             << "1:1"
+                                             << "2:1";
+    for (int step = 1; step <= scores.size(); step++) {
+        netAccess.setOverlayPath(QString(FIXTURE_OPENLIGADB "/live/%1").arg(step));
+
+        roundSpy.clear();
+        this->setGamesBeforeRecording();
+        reader.startRoundWithAllGames();
+        QVERIFY(roundSpy.count() > 0 || roundSpy.wait(ROUND_TIMEOUT_MSEC));
+        this->reportRound(QString("live %1").arg(step), reader.getLastRoundStats(), netAccess);
+
+        OnlineGameInfo* info = reader.onlineGame(SEASON_MATCH_DAYS);
+        QVERIFY(info != NULL);
+        QCOMPARE(info->m_score, scores[step - 1]);
+        QCOMPARE(reader.getLastRoundStats().m_changedGames, quint32(step == 3 ? 0 : 1));
+    }
+    QVERIFY(reader.onlineGame(SEASON_MATCH_DAYS)->m_gameFinished);
+}
+
+void ServerBench::handlerThroughput_data()
+{
+    QTest::addColumn<bool>("requestInfo");
+
+    QTest::newRow("info on") << true;
+    QTest::newRow("info off") << false;
+}
+
+/* enabled messages are still formatted, only the output is left out */
+static void discardMessage(QtMsgType type, const QMessageLogContext& context, const QString& msg)
+{
+    Q_UNUSED(type);
+    Q_UNUSED(context);
+    Q_UNUSED(msg);
+}
+
+/*
+ * Requests of an app which already has the games list, like after every start of the app.
+ * The handlers are run with the info messages of "stamorga.request" switched on and off.
+ */
+void ServerBench::handlerThroughput()
+{
+    QFETCH(bool, requestInfo);
+
+    qint64 kickOff = QDateTime::currentMSecsSinceEpoch();
+    for (int i = 0; i < BENCH_GAMES; i++) {
+        QString home = QString("Team %1").arg(i);
+        QVERIFY(this->m_globalData->m_GamesList.addNewGame(home, "KSC", kickOff + i * 3600000, i % SEASON_MATCH_DAYS + 1, "", LIGA_3, 2017) > 0);
+    }
+    for (int i = 0; i < BENCH_TICKETS; i++) {
+        QString name = QString("Ticket %1").arg(i);
+        QVERIFY(this->m_globalData->m_SeasonTicket.addNewSeasonTicket(BENCH_USER, 1, name, 0) > 0);
+    }
+
+    UserConData conData;
+    conData.m_userName = BENCH_USER;
+    DataConnection connection(this->m_globalData);
+    connection.setUserConnectionData(&conData);
+
+    qint64 lastUpdateGames = this->m_globalData->m_GamesList.getLastUpdateTime();
+
+    QByteArray  gamesListPayload;
+    QDataStream wGamesList(&gamesListPayload, QIODevice::WriteOnly);
+    wGamesList.setByteOrder(QDataStream::LittleEndian);
+    wGamesList << qint32(UpdateIndex::UpdateDiff) << lastUpdateGames;
+    MessageProtocol gamesListMsg(OP_CODE_CMD_REQ::REQ_GET_GAMES_LIST, gamesListPayload);
+
+    QByteArray  gamesInfoPayload;
+    QDataStream wGamesInfo(&gamesInfoPayload, QIODevice::WriteOnly);
+    wGamesInfo.setByteOrder(QDataStream::LittleEndian);
+    wGamesInfo << lastUpdateGames;
+    MessageProtocol gamesInfoMsg(OP_CODE_CMD_REQ::REQ_GET_GAMES_INFO_LIST, gamesInfoPayload);
+
+    QByteArray  ticketsPayload;
+    QDataStream wTickets(&ticketsPayload, QIODevice::WriteOnly);
+    wTickets.setByteOrder(QDataStream::LittleEndian);
+    wTickets << qint64(0);
+    MessageProtocol ticketsMsg(OP_CODE_CMD_REQ::REQ_GET_TICKETS_LIST, ticketsPayload);
+
+    MessageProtocol* ack = connection.requestGetGamesInfoList(&gamesInfoMsg);
+    QVERIFY(ack->getDataLength() > 4);
+    QCOMPARE(qFromLittleEndian(*(qint32*)ack->getPointerToData()), qint32(ERROR_CODE_SUCCESS));
+    delete ack;
+
+    QLoggingCategory::setFilterRules(QString(BENCH_LOG_RULES "\nstamorga.request.info=%1").arg(requestInfo ? "true" : "false"));
+    QtMessageHandler oldHandler = qInstallMessageHandler(discardMessage);
+
+    QBENCHMARK {
+        delete connection.requestGetGamesList(&gamesListMsg);
+        delete connection.requestGetGamesInfoList(&gamesInfoMsg);
+        delete connection.requestGetTicketsList(&ticketsMsg);
+    }
+
+    qInstallMessageHandler(oldHandler);
+    QLoggingCategory::setFilterRules(BENCH_LOG_RULES);
+}
+
+QTEST_GUILESS_MAIN(ServerBench)
+
+#include "bench_server.moc"
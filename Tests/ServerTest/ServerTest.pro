@@ -0,0 +1,58 @@
+##########################################################################################
+#	File:		ServerTest.pro
+#	Project:	StamOrga
+#
+#	Brief:		unit tests of the StFaeKSC server, run with make check
+#	Author:		msc
+#	Date:		19.10.2026
+#
+###########################################################################################
+
+
+QT += core network testlib
+QT -= gui
+
+CONFIG += c++11
+CONFIG += console testcase
+CONFIG -= app_bundle
+
+TARGET = tst_readonlinegames
+
+TEMPLATE = app
+
+
+include (../Tests.pri)
+
+# the server includes "../Common/..." relative to its project folder
+INCLUDEPATH += ../../StFaeKSC
+
+
+SOURCES += tst_readonlinegames.cpp \
+    ../Helper/fixturenetworkaccess.cpp \
+    ../../Common/General/backgroundcontroller.cpp \
+    ../../Common/General/backgroundworker.cpp \
+    ../../Common/General/globalfunctions.cpp \
+    ../../StFaeKSC/General/globaldata.cpp \
+    ../../StFaeKSC/General/serverstatistics.cpp \
+    ../../StFaeKSC/Data/listeduser.cpp \
+    ../../StFaeKSC/Data/games.cpp \
+    ../../StFaeKSC/Data/seasonticket.cpp \
+    ../../StFaeKSC/Data/configlist.cpp \
+    ../../StFaeKSC/Data/readonlinegames.cpp \
+    ../../StFaeKSC/Data/availablegameticket.cpp \
+    ../../StFaeKSC/Data/meetinginfo.cpp
+
+HEADERS += \
+    ../Helper/fixturenetworkaccess.h \
+    ../../Common/General/backgroundcontroller.h \
+    ../../Common/General/backgroundworker.h \
+    ../../Common/General/globalfunctions.h \
+    ../../StFaeKSC/General/globaldata.h \
+    ../../StFaeKSC/General/serverstatistics.h \
+    ../../StFaeKSC/Data/listeduser.h \
+    ../../StFaeKSC/Data/games.h \
+    ../../StFaeKSC/Data/seasonticket.h \
+    ../../StFaeKSC/Data/configlist.h \
+    ../../StFaeKSC/Data/readonlinegames.h \
+    ../../StFaeKSC/Data/availablegameticket.h \
+    ../../StFaeKSC/Data/meetinginfo.h
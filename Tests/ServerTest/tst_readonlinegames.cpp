@@ -0,0 +1,263 @@
+/*
+*	This file is part of StamOrga
+*   Copyright (C) 2017 Markus Schneider
+*
+*	This program is free software; you can redistribute it and/or modify
+*   it under the terms of the GNU General Public License as published by
+*   the Free Software Foundation; either version 3 of the License, or
+*   (at your option) any later version.
+*
+*	StamOrga is distributed in the hope that it will be useful,
+*    but WITHOUT ANY WARRANTY; without even the implied warranty of
+*    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+*    GNU General Public License for more details.
+
+*    You should have received a copy of the GNU General Public License
+*    along with StamOrga.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include <QtCore/QFile>
+#include <QtCore/QJsonArray>
+#include <QtCore/QJsonDocument>
+#include <QtCore/QTemporaryDir>
+#include <QtTest/QSignalSpy>
+#include <QtTest/QtTest>
+
+#include "../../StFaeKSC/Data/readonlinegames.h"
+#include "../../StFaeKSC/General/globaldata.h"
+#include "../Helper/fixturenetworkaccess.h"
+
+#define FIXTURE_SEASON FIXTURE_PATH "/openligadb/season"
+#define ROUND_TIMEOUT_MSEC 10000
+#define SEASON_MATCH_DAYS 38
+
+/* Gives the test access to the state of the reader */
+class TestReadOnlineGames : public ReadOnlineGames
+{
+public:
+    using ReadOnlineGames::findNextArrayObject;
+    using ReadOnlineGames::readLastUpdateTime;
+
+    QList<OnlineGameInfo*>& onlineGames() { return this->m_onlineGames; }
+
+    void readConfig() { this->readOnlineGamesConfig(); }
+
+    /* returns the updates the answer gave for the game */
+    QList<GameUpdate> readAnswer(OnlineGameInfo* info, const QByteArray& answer)
+    {
+        this->m_currentGameInfo = info;
+        this->readRequestAnswer(answer);
+        this->m_currentGameInfo = NULL;
+
+        QList<GameUpdate> rValue = this->m_lGameUpdates;
+        this->m_lGameUpdates.clear();
+        return rValue;
+    }
+};
+
+class ReadOnlineGamesTest : public QObject
+{
+    Q_OBJECT
+
+private slots:
+    void init();
+    void cleanup();
+
+    void parallelAnswersAreAppliedInRequestOrder();
+    void arrayObjectsAreTheJsonArray();
+    void filteredAnswerIsTheJsonGame_data();
+    void filteredAnswerIsTheJsonGame();
+    void knownGameIsNotTakenFromOtherGame();
+
+private:
+    QTemporaryDir* m_home;
+    GlobalData*    m_globalData;
+
+    QByteArray readMatchDay(int matchDay);
+    QJsonObject findTrackedGame(const QJsonArray& games, const QStringList& names);
+};
+
+/* Every test gets an empty home, the games list and the online state are stored there */
+void ReadOnlineGamesTest::init()
+{
+    this->m_home = new QTemporaryDir();
+    QVERIFY(this->m_home->isValid());
+    qputenv("HOME", this->m_home->path().toUtf8());
+
+    this->m_globalData = new GlobalData();
+    this->m_globalData->initialize();
+}
+
+void ReadOnlineGamesTest::cleanup()
+{
+    delete this->m_globalData;
+    delete this->m_home;
+}
+
+/*
+ * The later matchdays are answered first, the games still have to get their index in the
+ * order of the matchdays like when they are requested one after the other
+ */
+void ReadOnlineGamesTest::parallelAnswersAreAppliedInRequestOrder()
+{
+#if (QT_VERSION < QT_VERSION_CHECK(5, 8, 0))
+    QSKIP("ReadOnlineGames does not send requests before Qt 5.8");
+#endif
+    const int countMatchDays = 8;
+    QVERIFY(FixtureNetworkAccess::writeOnlineConfig(countMatchDays, QStringList() << "Karlsruher SC=KSC"));
+
+    FixtureNetworkAccess netAccess(FIXTURE_SEASON);
+    for (int i = 1; i <= countMatchDays; i++)
+        netAccess.setReplyDelay(QString("getmatchdata/bl3/2017/%1").arg(i), (countMatchDays + 1 - i) * 25);
+
+    TestReadOnlineGames reader;
+    reader.initialize(this->m_globalData);
+    reader.setNetworkAccess(&netAccess);
+
+    QSignalSpy roundSpy(&reader, SIGNAL(signalOnlineRoundFinished()));
+    reader.startBackgroundWork();
+    QVERIFY(roundSpy.count() > 0 || roundSpy.wait(ROUND_TIMEOUT_MSEC));
+
+    QCOMPARE(netAccess.requestedPaths().size(), countMatchDays);
+    QVERIFY2(netAccess.finishedPaths() != netAccess.requestedPaths(), "answers were not out of order");
+
+    QCOMPARE(reader.onlineGames().size(), countMatchDays);
+    for (int i = 0; i < countMatchDays; i++)
+        QCOMPARE(reader.onlineGames()[i]->m_index, quint32(i + 1));
+
+    Games& games = this->m_globalData->m_GamesList;
+    QCOMPARE(games.getNumberOfInternalList(), countMatchDays);
+    quint32 lastIndex = 0;
+    for (int i = 0; i < games.getNumberOfInternalList(); i++) {
+        GamesPlay* pGame = (GamesPlay*)games.getRequestConfigItemFromListIndex(i);
+        QVERIFY(pGame != NULL);
+        QCOMPARE(quint32(pGame->m_saisonIndex), quint32(i + 1));
+        QVERIFY(pGame->m_index > lastIndex);
+        lastIndex = pGame->m_index;
+    }
+}
+
+QByteArray ReadOnlineGamesTest::readMatchDay(int matchDay)
+{
+    QFile file(QString(FIXTURE_SEASON "/getmatchdata/bl3/2017/%1.json").arg(matchDay));
+    if (!file.open(QIODevice::ReadOnly))
+        return QByteArray();
+    return file.readAll();
+}
+
+/* The first game of one of the teams, like it is found when the whole answer is parsed */
+QJsonObject ReadOnlineGamesTest::findTrackedGame(const QJsonArray& games, const QStringList& names)
+{
+    foreach (const QJsonValue& value, games) {
+        QJsonObject game = value.toObject();
+        if (names.contains(game.value("Team1").toObject().value("TeamName").toString())
+            || names.contains(game.value("Team2").toObject().value("TeamName").toString()))
+            return game;
+    }
+    return QJsonObject();
+}
+
+/* Braces in strings and nested arrays must not end an object early */
+void ReadOnlineGamesTest::arrayObjectsAreTheJsonArray()
+{
+    for (int matchDay = 1; matchDay <= SEASON_MATCH_DAYS; matchDay++) {
+        QByteArray answer = this->readMatchDay(matchDay);
+        QVERIFY(!answer.isEmpty());
+        QJsonArray games = QJsonDocument::fromJson(answer).array();
+        QVERIFY(games.size() > 0);
+
+        int pos = 0, begin = 0, end = 0, count = 0;
+        while (TestReadOnlineGames::findNextArrayObject(answer, pos, begin, end)) {
+            QVERIFY(count < games.size());
+            QJsonParseError error;
+            QJsonDocument   object = QJsonDocument::fromJson(answer.mid(begin, end - begin), &error);
+            QCOMPARE(error.error, QJsonParseError::NoError);
+            QCOMPARE(object.object(), games[count].toObject());
+            count++;
+        }
+        QCOMPARE(count, games.size());
+    }
+}
+
+void ReadOnlineGamesTest::filteredAnswerIsTheJsonGame_data()
+{
+    QTest::addColumn<QStringList>("teams");
+
+    /* Würzburg is written as W\u00fcrzburg on the even matchdays, the name of KSC is also in
+     * strings of other games on matchday 3, 17 and 30 */
+    QTest::newRow("plain name") << (QStringList() << "Karlsruher SC=KSC");
+    QTest::newRow("escaped name") << (QStringList() << QString::fromUtf8("FC Würzburger Kickers=FWK"));
+    QTest::newRow("both") << (QStringList() << "Karlsruher SC=KSC" << QString::fromUtf8("FC Würzburger Kickers=FWK"));
+}
+
+/* The filter for the team name first has to find the same game as parsing the whole answer */
+void ReadOnlineGamesTest::filteredAnswerIsTheJsonGame()
+{
+    QFETCH(QStringList, teams);
+    QVERIFY(FixtureNetworkAccess::writeOnlineConfig(SEASON_MATCH_DAYS, teams));
+
+    QStringList names;
+    foreach (const QString& team, teams)
+        names.append(team.section('=', 0, 0));
+
+    TestReadOnlineGames reader;
+    reader.initialize(this->m_globalData);
+    reader.readConfig();
+
+    for (int matchDay = 1; matchDay <= SEASON_MATCH_DAYS; matchDay++) {
+        QByteArray  answer   = this->readMatchDay(matchDay);
+        QJsonObject expected = this->findTrackedGame(QJsonDocument::fromJson(answer).array(), names);
+        QVERIFY(!expected.isEmpty());
+
+        OnlineGameInfo* info = new OnlineGameInfo();
+        info->m_competition  = "bl3";
+        info->m_season       = 2017;
+        info->m_index        = matchDay;
+
+        QList<GameUpdate> updates = reader.readAnswer(info, answer);
+        QCOMPARE(updates.size(), 1);
+        QCOMPARE(info->m_matchID, quint32(expected.value("MatchID").toInt()));
+        QCOMPARE(info->m_lastUpdate, reader.readLastUpdateTime(expected.value("LastUpdateDateTime").toString()));
+        QCOMPARE(info->m_gameFinished, expected.value("MatchIsFinished").toBool());
+
+        QString team1 = expected.value("Team1").toObject().value("TeamName").toString();
+        QString team2 = expected.value("Team2").toObject().value("TeamName").toString();
+        QVERIFY(updates[0].m_home == team1 || updates[0].m_away == team2);
+        QCOMPARE(int(updates[0].m_saisonIndex), matchDay);
+    }
+}
+
+/*
+ * A known game with the same last update as another game, which has the team name in one of
+ * its strings, must not be taken as unchanged from that other game
+ */
+void ReadOnlineGamesTest::knownGameIsNotTakenFromOtherGame()
+{
+    QVERIFY(FixtureNetworkAccess::writeOnlineConfig(SEASON_MATCH_DAYS, QStringList() << "Karlsruher SC=KSC"));
+
+    TestReadOnlineGames reader;
+    reader.initialize(this->m_globalData);
+    reader.readConfig();
+
+    QByteArray  answer  = this->readMatchDay(3);
+    QJsonArray  games   = QJsonDocument::fromJson(answer).array();
+    QJsonObject tracked = this->findTrackedGame(games, QStringList() << "Karlsruher SC");
+    QJsonObject other   = games[0].toObject();
+    QVERIFY(other != tracked);
+    QVERIFY(answer.indexOf("Karlsruher SC") < answer.indexOf(QString("\"MatchID\":%1").arg(tracked.value("MatchID").toInt()).toUtf8()));
+
+    OnlineGameInfo* info = new OnlineGameInfo();
+    info->m_competition  = "bl3";
+    info->m_season       = 2017;
+    info->m_index        = 3;
+    info->m_matchID      = tracked.value("MatchID").toInt();
+    info->m_lastUpdate   = reader.readLastUpdateTime(other.value("LastUpdateDateTime").toString());
+
+    QList<GameUpdate> updates = reader.readAnswer(info, answer);
+    QCOMPARE(updates.size(), 1);
+    QCOMPARE(info->m_lastUpdate, reader.readLastUpdateTime(tracked.value("LastUpdateDateTime").toString()));
+}
+
+QTEST_GUILESS_MAIN(ReadOnlineGamesTest)
+
+#include "tst_readonlinegames.moc"
@@ -0,0 +1,15 @@
+##########################################################################################
+#	File:		Tests.pri
+#	Project:	StamOrga
+#
+#	Brief:		common project file for the tests and benchmarks
+#	Author:		msc
+#	Date:		19.10.2026
+#
+###########################################################################################
+
+
+include ($$PWD/../StamOrga.pri)
+
+# recorded answers of openligadb, see Helper/fixturenetworkaccess.h
+DEFINES += FIXTURE_PATH=\\\"$$PWD/Fixtures\\\"
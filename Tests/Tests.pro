@@ -0,0 +1,17 @@
+##########################################################################################
+#	File:		Tests.pro
+#	Project:	StamOrga
+#
+#	Brief:		unit tests and benchmarks of StamOrga, tests are run with make check
+#	Author:		msc
+#	Date:		19.10.2026
+#
+###########################################################################################
+
+
+TEMPLATE = subdirs
+
+SUBDIRS += \
+    ServerTest \
+    ServerBench \
+    AppBench